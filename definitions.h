@@ -38,6 +38,8 @@
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
 #include "rrlib/rtti/rtti.h"
+#include "rrlib/time/time.h"
+#include <type_traits>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
@@ -54,6 +56,7 @@ namespace rpc_ports
 //----------------------------------------------------------------------
 // Forward declarations / typedefs / enums
 //----------------------------------------------------------------------
+class tRPCBuffer;
 
 /*!
  * Status of call a future is waiting for
@@ -84,6 +87,70 @@ enum class tCallType
   UNSPECIFIED
 };
 
+/*!
+ * How threads wait for the result of a call
+ */
+enum class tWaitMode : uint8_t
+{
+  BLOCK,           //!< Block (futex) immediately if result is not available
+  SPIN_THEN_BLOCK, //!< Spin a limited number of iterations - then block
+  BUSY_POLL        //!< Poll until result is available or timeout expires (never blocks - occupies a CPU core while waiting)
+};
+
+/*!
+ * Policy for waiting for results of calls.
+ * For fast transports (e.g. shared memory), responses often arrive within a few microseconds.
+ * Spinning is cheaper than blocking and waking the waiting thread in this case.
+ */
+struct tWaitPolicy
+{
+  /*! Default number of spin iterations for SPIN_THEN_BLOCK mode */
+  enum { cDEFAULT_SPIN_ITERATIONS = 2000 };
+
+  /*! Wait mode */
+  tWaitMode mode;
+
+  /*! Number of spin iterations in SPIN_THEN_BLOCK mode (each iteration includes a pause instruction) */
+  uint32_t spin_iterations;
+
+  tWaitPolicy(tWaitMode mode = tWaitMode::BLOCK, uint32_t spin_iterations = cDEFAULT_SPIN_ITERATIONS) :
+    mode(mode),
+    spin_iterations(spin_iterations)
+  {}
+};
+
+/*!
+ * How server ports synchronize calls to server functions
+ */
+enum class tServerSynchronization : uint8_t
+{
+  NONE,         //!< Framework does not synchronize calls (server functions need to be thread-safe)
+  READER_WRITER //!< Const functions are executed concurrently - non-const functions get exclusive access
+};
+
+/*!
+ * Can values of type T be transferred as memory image in RPC parameters and return values
+ * (see internal::tWireFormat::SetRawBlocksEnabled())?
+ *
+ * True for arithmetic and enum types. Classes need to opt in by specializing this template.
+ * This is only valid for plain data types (trivially copyable, standard layout, no pointers) whose
+ * stream operators serialize exactly their fields - e.g. poses and twists.
+ * Opted-in types must not contain padding bytes: the memory image is sent as it is - so padding would
+ * leak uninitialized memory to the network (check with a static_assert on the type's size).
+ * Specialization needs to be in namespace finroc::rpc_ports:
+ *
+ *   template <>
+ *   struct tRawBlockSerializable<tPose3D>
+ *   {
+ *     enum { value = 1 };
+ *   };
+ */
+template <typename T>
+struct tRawBlockSerializable
+{
+  enum { value = std::is_arithmetic<T>::value || std::is_enum<T>::value };
+};
+
 /*!
  * \param type Data type to check
  * \return Is specified data type a RPC interface type?
@@ -99,6 +166,7 @@ namespace internal
 class tRPCPort;
 class tCallStorage;
 class tResponseSender;
+class tWireFormat;
 
 /*!
  * Call id that is attached to requests and responses in order to identify
@@ -107,13 +175,16 @@ class tResponseSender;
 typedef uint64_t tCallId;
 
 /*! Function that deserializes and executes message from stream */
-typedef void (*tDeserializeMessage)(rrlib::serialization::tInputStream&, tRPCPort&, uint8_t);
+typedef void (*tDeserializeMessage)(rrlib::serialization::tInputStream&, tRPCPort&, uint8_t, const tWireFormat&);
 
 /*! Function that deserializes and executes call from stream */
-typedef void (*tDeserializeRequest)(rrlib::serialization::tInputStream&, tRPCPort&, uint8_t, tResponseSender& response_sender);
+typedef void (*tDeserializeRequest)(rrlib::serialization::tInputStream&, tRPCPort&, uint8_t, tResponseSender& response_sender, const tWireFormat&);
+
+/*! Function that forwards request with serialized parameters to a network port (see tRPCInterfaceTypeInfo::ForwardRequest()) */
+typedef void (*tForwardRequest)(tRPCPort&, uint8_t, tCallId, const rrlib::time::tDuration&, tRPCBuffer&&, tResponseSender&, const tWireFormat&);
 
 /*! Function that deserializes and handles response from stream */
-typedef void (*tDeserializeResponse)(rrlib::serialization::tInputStream&, const rrlib::rtti::tType&, uint8_t, tResponseSender&, tCallStorage*);
+typedef void (*tDeserializeResponse)(rrlib::serialization::tInputStream&, const rrlib::rtti::tType&, uint8_t, tResponseSender&, tCallStorage*, const tWireFormat&);
 
 } // namespace internal
 
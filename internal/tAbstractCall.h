@@ -47,6 +47,7 @@
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "plugins/rpc_ports/internal/tWireFormat.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -86,18 +87,38 @@ public:
 
   virtual ~tAbstractCall();
 
+  /*!
+   * Deserializes/receives return value from stream (in legacy wire format)
+   */
+  void ReturnValue(rrlib::serialization::tInputStream& stream, tResponseSender& response_sender)
+  {
+    ReturnValue(stream, response_sender, tWireFormat::Legacy());
+  }
+
   /*!
    * Deserializes/receives return value from stream
+   *
+   * \param wire_format Wire format of the connection the return value was received from
    */
-  virtual void ReturnValue(rrlib::serialization::tInputStream& stream, tResponseSender& response_sender)
+  virtual void ReturnValue(rrlib::serialization::tInputStream& stream, tResponseSender& response_sender, const tWireFormat& wire_format)
   {
     throw new std::runtime_error("This is a call without return value");
   }
 
+  /*!
+   * Serializes call to stream (in legacy wire format)
+   */
+  void Serialize(rrlib::serialization::tOutputStream& stream)
+  {
+    Serialize(stream, tWireFormat::Legacy());
+  }
+
   /*!
    * Serializes call to stream
+   *
+   * \param wire_format Wire format of the connection the call is sent over
    */
-  virtual void Serialize(rrlib::serialization::tOutputStream& stream) = 0;
+  virtual void Serialize(rrlib::serialization::tOutputStream& stream, tWireFormat& wire_format) = 0;
 
 //----------------------------------------------------------------------
 // Private fields and methods
@@ -0,0 +1,108 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/internal/tCallIdGenerator.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tCallIdGenerator
+ *
+ * \b tCallIdGenerator
+ *
+ * Generates unique call ids for network transports that do not use tPendingCallTable.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__rpc_ports__internal__tCallIdGenerator_h__
+#define __plugins__rpc_ports__internal__tCallIdGenerator_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <atomic>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/definitions.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Generator for call ids
+/*!
+ * Generates call ids that are unique in this process
+ * (for network transports that do not use tPendingCallTable - which assigns call ids itself).
+ *
+ * Each thread obtains blocks of cBLOCK_SIZE ids from a global counter and hands them out locally -
+ * so that generating ids does not bounce a cache line between cores.
+ * Ids are therefore unique, but not ordered across threads. Id 0 is never generated.
+ */
+class tCallIdGenerator
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*! Number of ids each thread obtains from global counter at once */
+  enum { cBLOCK_SIZE = 1024 };
+
+  /*!
+   * \return New unique call id
+   */
+  static tCallId Next();
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! First id of next block that is handed out to a thread */
+  static std::atomic<tCallId> next_block;
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -0,0 +1,140 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/internal/tCallMailbox.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tCallMailbox
+ *
+ * \b tCallMailbox
+ *
+ * Lock-free multiple-producer single-consumer queue for calls.
+ * Calls are linked intrusively via their storage objects - so enqueueing does not allocate memory.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__rpc_ports__internal__tCallMailbox_h__
+#define __plugins__rpc_ports__internal__tCallMailbox_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/internal/tCallStorage.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Mailbox for calls
+/*!
+ * Lock-free multiple-producer single-consumer queue for calls.
+ * Calls are linked intrusively via their storage objects (tQueueable link) - so enqueueing does not allocate memory.
+ * The consumer always takes all calls in the mailbox at once (batch processing).
+ */
+class tCallMailbox : private rrlib::util::tNoncopyable
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  tCallMailbox() :
+    head(NULL)
+  {}
+
+  /*! Deletes any calls left in mailbox */
+  ~tCallMailbox();
+
+  /*!
+   * Adds call to mailbox (may be called by multiple threads concurrently)
+   *
+   * \param call Call to add
+   * \return True if mailbox was empty before (consumer might need to be woken up)
+   */
+  bool Push(tCallStorage::tPointer && call)
+  {
+    tCallStorage* node = call.release();
+    tCallStorage* old_head = head.load(std::memory_order_relaxed);
+    do
+    {
+      node->next_queueable.store(old_head, std::memory_order_relaxed);
+    }
+    while (!head.compare_exchange_weak(old_head, node, std::memory_order_seq_cst, std::memory_order_relaxed)); // seq_cst: see tSerialExecutor::Dispatch()
+    return old_head == NULL;
+  }
+
+  /*!
+   * \return True if mailbox contains no calls
+   */
+  bool Empty() const
+  {
+    return head.load() == NULL;
+  }
+
+  /*!
+   * Takes all calls from mailbox (may only be called by one thread at a time)
+   *
+   * \param calls Vector to append calls to (in the order they were added to mailbox)
+   * \return Number of calls taken
+   */
+  size_t TakeAll(std::vector<tCallStorage::tPointer>& calls);
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Last call that was added to mailbox (calls are linked in reverse order) */
+  std::atomic<tCallStorage*> head;
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -32,6 +32,8 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include <array>
+#include <thread>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
@@ -67,23 +69,182 @@ namespace internal
 //----------------------------------------------------------------------
 // Implementation
 //----------------------------------------------------------------------
-typename tCallStorage::tCallStorageBufferPool tCallStorage::call_storage_buffer_pool;
+typename tCallStorage::tCallStorageBufferPool tCallStorage::call_storage_buffer_pools[static_cast<size_t>(tSizeClass::DIMENSION)];
 
-tCallStorage::tCallStorage() :
+const size_t tCallStorage::cINLINE_MEMORY_OFFSET = ((sizeof(tCallStorage) + cMEMORY_ALIGNMENT - 1) / cMEMORY_ALIGNMENT) * cMEMORY_ALIGNMENT;
+
+namespace
+{
+
+/*! Global cache statistics (thread-local counts are added in batches) */
+std::atomic<uint64_t> global_local_hits(0), global_refills(0), global_refilled_buffers(0), global_drains(0);
+
+/*! Set when the current thread's cache has been destructed (thread is exiting) */
+thread_local bool thread_local_cache_destructed = false;
+
+/*! Number of spin iterations after which deadline is checked */
+const uint32_t cDEADLINE_CHECK_INTERVAL = 64;
+
+/*!
+ * Hint to CPU that thread is spinning
+ */
+inline void CpuRelax()
+{
+#if defined(__i386__) || defined(__x86_64__)
+  __builtin_ia32_pause();
+#elif defined(__arm__) || defined(__aarch64__)
+  asm volatile("yield");
+#else
+  std::this_thread::yield();
+#endif
+}
+
+}
+
+/*!
+ * Magazines of unused storage objects (one per size class) that belong to a single thread.
+ * Refills from and drains to the global buffer pools in batches.
+ */
+class tCallStorage::tThreadLocalCache
+{
+public:
+
+  tThreadLocalCache() :
+    magazines(),
+    local_hits(0)
+  {}
+
+  ~tThreadLocalCache()
+  {
+    for (size_t i = 0; i < magazines.size(); i++)
+    {
+      Drain(magazines[i], magazines[i].size);
+    }
+    FlushStatistics();
+    thread_local_cache_destructed = true;
+  }
+
+  /*!
+   * \param size_class Size class of storage object
+   * \return Unused storage object - from cache if possible
+   */
+  tCallStorage* Get(tSizeClass size_class)
+  {
+    tMagazine& magazine = magazines[static_cast<size_t>(size_class)];
+    if (magazine.size)
+    {
+      local_hits++;
+      magazine.size--;
+      return magazine.buffers[magazine.size];
+    }
+
+    // Refill from global pool
+    tCallStorageBufferPool& pool = call_storage_buffer_pools[static_cast<size_t>(size_class)];
+    for (; magazine.size < cCACHE_BATCH_SIZE; magazine.size++)
+    {
+      typename tCallStorageBufferPool::tPointer buffer = pool.GetUnusedBuffer();
+      if (!buffer)
+      {
+        break;
+      }
+      magazine.buffers[magazine.size] = buffer.release();
+    }
+    global_refills.fetch_add(1, std::memory_order_relaxed);
+    global_refilled_buffers.fetch_add(magazine.size, std::memory_order_relaxed);
+    FlushStatistics();
+    if (magazine.size)
+    {
+      magazine.size--;
+      return magazine.buffers[magazine.size];
+    }
+    return Create(size_class);
+  }
+
+  /*!
+   * Puts unused storage object in cache
+   */
+  void Put(tCallStorage* storage)
+  {
+    tMagazine& magazine = magazines[static_cast<size_t>(storage->size_class)];
+    if (magazine.size == cTHREAD_LOCAL_CACHE_SIZE)
+    {
+      Drain(magazine, cCACHE_BATCH_SIZE);
+      global_drains.fetch_add(1, std::memory_order_relaxed);
+      FlushStatistics();
+    }
+    magazine.buffers[magazine.size] = storage;
+    magazine.size++;
+  }
+
+private:
+
+  /*! Cached storage objects of one size class */
+  struct tMagazine
+  {
+    /*! Cached storage objects */
+    std::array<tCallStorage*, cTHREAD_LOCAL_CACHE_SIZE> buffers;
+
+    /*! Number of storage objects in magazine */
+    size_t size;
+  };
+
+  /*! Magazines - one for each size class */
+  std::array<tMagazine, static_cast<size_t>(tSizeClass::DIMENSION)> magazines;
+
+  /*! Number of cache hits not yet added to global statistics */
+  uint64_t local_hits;
+
+
+  /*!
+   * Returns storage objects to global pool
+   *
+   * \param magazine Magazine to return objects from
+   * \param count Number of objects to return
+   */
+  void Drain(tMagazine& magazine, size_t count)
+  {
+    tBufferReturner returner;
+    for (size_t i = 0; i < count && magazine.size > 0; i++)
+    {
+      magazine.size--;
+      returner(magazine.buffers[magazine.size]);
+    }
+  }
+
+  void FlushStatistics()
+  {
+    global_local_hits.fetch_add(local_hits, std::memory_order_relaxed);
+    local_hits = 0;
+  }
+};
+
+thread_local tCallStorage::tThreadLocalCache tCallStorage::thread_local_cache;
+
+thread_local void (*tCallStorage::flush_collected_calls_hook)() = NULL;
+
+tCallStorage::tCallStorage(tSizeClass size_class) :
   empty(true),
-  mutex(),
-  condition_variable(),
-  waiting(false),
   future_status((int)tFutureStatus::PENDING),
   call_ready_for_sending(NULL),
   reference_counter(0),
   response_handler(NULL),
   response_timeout(std::chrono::seconds(0)),
+  deadline(tDeadline::max()),
   call_id(0),
   call_type(tCallType::UNSPECIFIED),
   local_port_handle(0),
   remote_port_handle(0),
-  storage_memory()
+  size_class(size_class),
+  in_timer_wheel(false),
+  timer_wheel_next(NULL),
+  timer_wheel_prev(NULL),
+  timer_wheel_next_removed(NULL),
+  timer_wheel_slot(NULL),
+  timer_wheel_tick(0),
+  timer_wheel_added(false),
+  storage_memory(NULL),
+  heap_memory(),
+  heap_memory_size(0)
 {}
 
 tCallStorage::~tCallStorage()
@@ -91,26 +252,75 @@ tCallStorage::~tCallStorage()
   Clear();
 }
 
-typename tCallStorage::tPointer tCallStorage::GetUnused()
+tCallStorage* tCallStorage::Create(tSizeClass size_class)
+{
+  // Inline memory is allocated directly behind object
+  void* memory = ::operator new(cINLINE_MEMORY_OFFSET + GetInlineMemorySize(size_class));
+  std::unique_ptr<tCallStorage> new_buffer(new(memory) tCallStorage(size_class));
+  return call_storage_buffer_pools[static_cast<size_t>(size_class)].AddBuffer(std::move(new_buffer)).release();
+}
+
+typename tCallStorage::tCacheStatistics tCallStorage::GetCacheStatistics()
 {
-  typename tCallStorageBufferPool::tPointer buffer = call_storage_buffer_pool.GetUnusedBuffer();
-  if (!buffer)
+  tCacheStatistics result =
   {
-    std::unique_ptr<tCallStorage> new_buffer(new tCallStorage());
-    buffer = call_storage_buffer_pool.AddBuffer(std::move(new_buffer));
+    global_local_hits.load(std::memory_order_relaxed),
+    global_refills.load(std::memory_order_relaxed),
+    global_refilled_buffers.load(std::memory_order_relaxed),
+    global_drains.load(std::memory_order_relaxed)
+  };
+  return result;
+}
+
+typename tCallStorage::tPointer tCallStorage::GetUnused(tSizeClass size_class)
+{
+  tCallStorage* buffer = NULL;
+  if (!thread_local_cache_destructed)
+  {
+    buffer = thread_local_cache.Get(size_class);
+  }
+  else
+  {
+    buffer = call_storage_buffer_pools[static_cast<size_t>(size_class)].GetUnusedBuffer().release();
+    if (!buffer)
+    {
+      buffer = Create(size_class);
+    }
   }
   buffer->reference_counter.store(1);
+  buffer->future_status.store(static_cast<int>(tFutureStatus::PENDING));
   buffer->call_ready_for_sending = NULL;
   buffer->response_timeout = std::chrono::seconds(0);
-  return tPointer(buffer.release());
+  buffer->deadline = tDeadline::max();
+  return tPointer(buffer);
+}
+
+void tCallStorage::Recycle(tCallStorage* storage)
+{
+  if (!thread_local_cache_destructed)
+  {
+    thread_local_cache.Put(storage);
+  }
+  else
+  {
+    tBufferReturner returner;
+    returner(storage);
+  }
 }
 
 void tCallStorage::SetException(tFutureStatus new_status)
 {
-  tFutureStatus current = (tFutureStatus)future_status.load();
+  tFutureStatus current = GetFutureStatus();
   if (current != tFutureStatus::PENDING)
   {
-    FINROC_LOG_PRINT(WARNING, "Exception cannot be set twice. Ignoring.");
+    if (current == tFutureStatus::TIMEOUT)
+    {
+      FINROC_LOG_PRINT(DEBUG, "Call has already timed out. Ignoring exception.");
+    }
+    else
+    {
+      FINROC_LOG_PRINT(WARNING, "Exception cannot be set twice. Ignoring.");
+    }
     return;
   }
 
@@ -119,14 +329,80 @@ void tCallStorage::SetException(tFutureStatus new_status)
     throw std::runtime_error("Invalid value for exception");
   }
 
-  rrlib::thread::tLock lock(mutex);
-  future_status.store((int)new_status);
-  condition_variable.notify_one();
-  if (response_handler)
+  tAbstractResponseHandler* handler = Complete(new_status);
+  if (handler)
+  {
+    handler->HandleException(new_status);
+  }
+}
+
+tFutureStatus tCallStorage::WaitForCompletion(const rrlib::time::tDuration& timeout, const tWaitPolicy& wait_policy)
+{
+  int state = future_status.load();
+  if ((state & cSTATUS_MASK) != static_cast<int>(tFutureStatus::PENDING))
+  {
+    return static_cast<tFutureStatus>(state & cSTATUS_MASK);
+  }
+  FlushCollectedCalls(); // call we wait for might not have been sent yet
+  std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+
+  // Spin (without announcing waiter - so completing thread does not need to wake us)
+  if (wait_policy.mode != tWaitMode::BLOCK)
+  {
+    bool busy_poll = wait_policy.mode == tWaitMode::BUSY_POLL;
+    for (uint32_t i = 1; busy_poll || i <= wait_policy.spin_iterations; i++)
+    {
+      CpuRelax();
+      state = future_status.load();
+      if ((state & cSTATUS_MASK) != static_cast<int>(tFutureStatus::PENDING))
+      {
+        return static_cast<tFutureStatus>(state & cSTATUS_MASK);
+      }
+      if (i % cDEADLINE_CHECK_INTERVAL == 0 && std::chrono::steady_clock::now() >= deadline)
+      {
+        if (busy_poll)
+        {
+          return tFutureStatus::TIMEOUT;
+        }
+        break;
+      }
+    }
+  }
+
+  // Block
+  if ((state & cWAITER_FLAG) || (!future_status.compare_exchange_strong(state, state | cWAITER_FLAG)))
+  {
+    if ((state & cSTATUS_MASK) != static_cast<int>(tFutureStatus::PENDING))
+    {
+      return static_cast<tFutureStatus>(state & cSTATUS_MASK);
+    }
+    FINROC_LOG_PRINT(ERROR, "There's already a thread waiting on this object");
+    return tFutureStatus::INVALID_CALL;
+  }
+
+  const int cWAITING_STATE = static_cast<int>(tFutureStatus::PENDING) | cWAITER_FLAG;
+  while (true)
+  {
+    rrlib::time::tDuration remaining = std::chrono::duration_cast<rrlib::time::tDuration>(deadline - std::chrono::steady_clock::now());
+    if (remaining <= rrlib::time::tDuration::zero())
+    {
+      break;
+    }
+    tFutex::Wait(future_status, cWAITING_STATE, remaining);
+    state = future_status.load();
+    if (state != cWAITING_STATE)
+    {
+      return static_cast<tFutureStatus>(state & cSTATUS_MASK);
+    }
+  }
+
+  // Timeout: remove waiter flag (call might complete concurrently)
+  state = cWAITING_STATE;
+  if (future_status.compare_exchange_strong(state, static_cast<int>(tFutureStatus::PENDING)))
   {
-    lock.Unlock();
-    response_handler->HandleException(new_status);
+    return tFutureStatus::TIMEOUT;
   }
+  return static_cast<tFutureStatus>(state & cSTATUS_MASK);
 }
 
 //----------------------------------------------------------------------
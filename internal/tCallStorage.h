@@ -49,6 +49,8 @@
 #include "plugins/rpc_ports/definitions.h"
 #include "plugins/rpc_ports/internal/tAbstractCall.h"
 #include "plugins/rpc_ports/internal/tAbstractResponseHandler.h"
+#include "plugins/rpc_ports/internal/tFutex.h"
+#include "plugins/rpc_ports/internal/tTimerWheel.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -74,9 +76,18 @@ namespace internal
 template <typename TReturn, typename ... TArgs>
 class tRPCRequest;
 
+template <typename TReturn, typename ... TArgs>
+class tForwardedRequest;
+
 template <typename TReturn>
 class tRPCResponse;
 
+template <typename T, typename TCallable>
+class tContinuation;
+
+template <typename TInterface, typename TFunction, typename TReturn, typename ... TArgs>
+class tServerCall;
+
 //----------------------------------------------------------------------
 // Class declaration
 //----------------------------------------------------------------------
@@ -127,15 +138,99 @@ public:
   typedef std::unique_ptr<tCallStorage, tLockReleaser<true>> tFuturePointer;
 
   /*!
-   * Storage size in bytes
-   * This is the maximum size of call classes stored in this object
+   * Absolute deadline of call (monotonic clock - not comparable across processes)
+   */
+  typedef std::chrono::steady_clock::time_point tDeadline;
+
+  /*!
+   * Size classes of storage objects.
+   * Calls are stored in the inline memory of the smallest size class they fit in.
+   * Objects of the HEAP class have no inline memory. Calls that do not fit
+   * into inline memory are stored in heap memory that is retained when the
+   * storage object is recycled.
+   */
+  enum class tSizeClass : uint8_t
+  {
+    SIZE_64,
+    SIZE_256,
+    SIZE_640,
+    SIZE_4K,
+    HEAP,
+    DIMENSION
+  };
+
+  /*!
+   * Inline storage size in bytes of objects returned by GetUnused() without template argument
+   * (calls of other types should obtain storage via GetUnused<TCallClass>())
    */
   enum { cSTORAGE_SIZE = 640 };
 
-  tCallStorage();
+  /*!
+   * Maximum number of unused storage objects each thread keeps in its local cache.
+   * GetUnused() and releasing locks only access the global buffer pool
+   * when this cache runs empty or full - and then in batches of cCACHE_BATCH_SIZE.
+   */
+  enum { cTHREAD_LOCAL_CACHE_SIZE = 64, cCACHE_BATCH_SIZE = cTHREAD_LOCAL_CACHE_SIZE / 2 };
+
+  /*!
+   * Statistics on thread-local cache usage
+   * (counts of threads are added to these values whenever they access the global pool or exit)
+   */
+  struct tCacheStatistics
+  {
+    /*! Number of GetUnused() calls served from a thread-local cache */
+    uint64_t local_hits;
+
+    /*! Number of GetUnused() calls that needed to refill thread-local cache from global pool */
+    uint64_t global_refills;
+
+    /*! Number of storage objects transferred from global pool to thread-local caches */
+    uint64_t refilled_buffers;
+
+    /*! Number of times a full thread-local cache was drained to global pool */
+    uint64_t global_drains;
+  };
+
+  tCallStorage(tSizeClass size_class);
 
   ~tCallStorage();
 
+  static void operator delete(void* p)
+  {
+    ::operator delete(p);
+  }
+
+
+  /*!
+   * Sets response handler - unless call has already completed
+   *
+   * \param handler Response handler to notify on completion
+   * \return True if handler was set and is notified on completion (possibly already concurrently).
+   *         False if call had already completed (handler is not notified).
+   */
+  bool AttachResponseHandler(tAbstractResponseHandler* handler)
+  {
+    response_handler.store(handler);
+    if (GetFutureStatus() == tFutureStatus::PENDING)
+    {
+      return true;
+    }
+
+    // Call completed concurrently: take handler back - unless completing thread already took it
+    return response_handler.exchange(NULL) != handler;
+  }
+
+  /*!
+   * Removes response handler that was set via AttachResponseHandler()
+   *
+   * \param handler Response handler to remove
+   * \return True if handler was removed before being notified. False if call completed and handler is (possibly concurrently) notified.
+   */
+  bool DetachResponseHandler(tAbstractResponseHandler* handler)
+  {
+    tAbstractResponseHandler* expected = handler;
+    return response_handler.compare_exchange_strong(expected, NULL);
+  }
 
   /*!
    * Clear contents of this object
@@ -147,7 +242,7 @@ public:
     {
       GetCall()->~tAbstractCall();
       empty = true;
-      response_handler = NULL;
+      response_handler.store(NULL);
     }
   }
 
@@ -160,14 +255,29 @@ public:
   TCallClass& Emplace(TArgs && ... constructor_arguments)
   {
     static_assert(std::is_base_of<tAbstractCall, TCallClass>::value, "Must be subclass of tAbstractCall");
-    CheckSize<sizeof(TCallClass)>();
+    static_assert(alignof(TCallClass) <= cMEMORY_ALIGNMENT, "TCallClass requires unsupported alignment");
     Clear();
+    storage_memory = GetMemory(sizeof(TCallClass));
     TCallClass& result = *(new(storage_memory) TCallClass(std::forward<TArgs>(constructor_arguments)...));
     empty = false;
     assert((&result == &static_cast<tAbstractCall&>(result)) && "tAbstractCall base class needs to be at offset zero");
     return result;
   }
 
+  /*!
+   * \param timeout Timeout relative to current time
+   * \return Deadline corresponding to timeout (tDeadline::max() if timeout is too large to be represented)
+   */
+  static tDeadline DeadlineFromTimeout(const rrlib::time::tDuration& timeout)
+  {
+    tDeadline now = std::chrono::steady_clock::now();
+    if (timeout >= std::chrono::duration_cast<rrlib::time::tDuration>(tDeadline::max() - now))
+    {
+      return tDeadline::max();
+    }
+    return now + std::chrono::duration_cast<tDeadline::duration>(timeout);
+  }
+
   /*!
    * \return Does this contain a call that expects a response?
    */
@@ -176,6 +286,26 @@ public:
     return response_timeout.count() != 0;
   }
 
+  /*!
+   * Sends calls that the current thread has collected but not sent yet (see tRPCPort::tBatchScope).
+   * Called before waiting for results - as the calls waited for might be among them.
+   */
+  static void FlushCollectedCalls()
+  {
+    if (flush_collected_calls_hook)
+    {
+      flush_collected_calls_hook();
+    }
+  }
+
+  /*!
+   * \return Deadline of call - after which nobody is waiting for its result anymore (tDeadline::max() if there is none)
+   */
+  tDeadline GetDeadline() const
+  {
+    return deadline;
+  }
+
   /*!
    * \return Pointer to call stored in this object - NULL if no call is currently stored
    */
@@ -217,9 +347,58 @@ public:
   }
 
   /*!
+   * \return Status of call (for future)
+   */
+  tFutureStatus GetFutureStatus() const
+  {
+    return static_cast<tFutureStatus>(future_status.load() & cSTATUS_MASK);
+  }
+
+  /*!
+   * \return Statistics on thread-local cache usage
+   */
+  static tCacheStatistics GetCacheStatistics();
+
+  /*!
+   * \param size_class Size class of storage object
    * \return Unused call storage buffer
    */
-  static tPointer GetUnused();
+  static tPointer GetUnused(tSizeClass size_class = GetSizeClass(cSTORAGE_SIZE));
+
+  /*!
+   * \tparam TCallClass Call class that will be stored in buffer
+   * \return Unused call storage buffer of the smallest size class TCallClass fits in
+   */
+  template <typename TCallClass>
+  static tPointer GetUnused()
+  {
+    enum { cSIZE_CLASS = static_cast<int>(GetSizeClass(sizeof(TCallClass))) };
+    return GetUnused(static_cast<tSizeClass>(cSIZE_CLASS));
+  }
+
+  /*!
+   * \param size_class Size class
+   * \return Size of inline memory of objects of specified size class
+   */
+  static constexpr size_t GetInlineMemorySize(tSizeClass size_class)
+  {
+    return size_class == tSizeClass::SIZE_64 ? 64 :
+           (size_class == tSizeClass::SIZE_256 ? 256 :
+            (size_class == tSizeClass::SIZE_640 ? 640 :
+             (size_class == tSizeClass::SIZE_4K ? 4096 : 0)));
+  }
+
+  /*!
+   * \param call_size Size of call class in bytes
+   * \return Smallest size class with inline memory that call class fits in (HEAP if there is none)
+   */
+  static constexpr tSizeClass GetSizeClass(size_t call_size)
+  {
+    return call_size <= 64 ? tSizeClass::SIZE_64 :
+           (call_size <= 256 ? tSizeClass::SIZE_256 :
+            (call_size <= 640 ? tSizeClass::SIZE_640 :
+             (call_size <= 4096 ? tSizeClass::SIZE_4K : tSizeClass::HEAP)));
+  }
 
   /*!
    * \return Is call ready for sending?
@@ -227,28 +406,39 @@ public:
    */
   bool ReadyForSending() const
   {
-    return (!call_ready_for_sending) || (call_ready_for_sending->load() != (int)tFutureStatus::PENDING);
+    return (!call_ready_for_sending) || ((call_ready_for_sending->load() & cSTATUS_MASK) != (int)tFutureStatus::PENDING);
   }
 
   template <bool FUTURE_POINTER>
   void ReleaseLock()
   {
+    // Release promise if there is some future still holding on to this buffer
+    // (must be done before releasing our reference: otherwise, the object might already be recycled and reused by another call)
+    if ((!FUTURE_POINTER) && reference_counter.load() > 1 && GetFutureStatus() == tFutureStatus::PENDING)
+    {
+      SetException(tFutureStatus::BROKEN_PROMISE);
+    }
+
     int old = reference_counter.fetch_sub(1);
     assert(old >= 1);
     if (old == 1)
     {
       Clear();
-      tBufferReturner returner;
-      returner(this);
+      Recycle(this);
     }
-    else if (!FUTURE_POINTER) // there is some future still holding on to this buffer
+  }
+
+  /*!
+   * \return Remaining time until deadline of call (zero if deadline has passed, rrlib::time::tDuration::max() if call has no deadline)
+   */
+  rrlib::time::tDuration RemainingTime() const
+  {
+    if (deadline == tDeadline::max())
     {
-      // Release promise
-      if (future_status.load() == (int)tFutureStatus::PENDING)
-      {
-        SetException(tFutureStatus::BROKEN_PROMISE);
-      }
+      return rrlib::time::tDuration::max();
     }
+    tDeadline now = std::chrono::steady_clock::now();
+    return now >= deadline ? rrlib::time::tDuration::zero() : std::chrono::duration_cast<rrlib::time::tDuration>(deadline - now);
   }
 
   /*!
@@ -260,7 +450,26 @@ public:
   }
 
   /*!
-   * \param call_id Identification of call in this process
+   * \param deadline Deadline of call - after which nobody is waiting for its result anymore
+   */
+  void SetDeadline(tDeadline deadline)
+  {
+    this->deadline = deadline;
+  }
+
+  /*!
+   * Sets timeout for response - and deadline of call accordingly
+   *
+   * \param timeout Timeout for response relative to current time
+   */
+  void SetResponseTimeout(const rrlib::time::tDuration& timeout)
+  {
+    response_timeout = timeout;
+    deadline = DeadlineFromTimeout(timeout);
+  }
+
+  /*!
+   * \param call_id Identification of call in this process (see tPendingCallTable and tCallIdGenerator)
    */
   void SetCallId(tCallId call_id)
   {
@@ -275,6 +484,16 @@ public:
    */
   void SetException(tFutureStatus new_status);
 
+  /*!
+   * Blocks until call completes (or timeout expires)
+   * Only one thread may wait for completion at a time.
+   *
+   * \param timeout Maximum time to wait
+   * \param wait_policy Policy for waiting (spinning and/or blocking)
+   * \return Status of call after waiting. TIMEOUT if timeout expired. INVALID_CALL if another thread is already waiting.
+   */
+  tFutureStatus WaitForCompletion(const rrlib::time::tDuration& timeout, const tWaitPolicy& wait_policy = tWaitPolicy());
+
   /*!
    * \param remote_port_handle Handle of remote port that call is meant for: Custom variable for network transport implementation
    */
@@ -297,30 +516,54 @@ private:
   template <typename TReturn, typename ... TArgs>
   friend class tRPCRequest;
 
+  template <typename TReturn, typename ... TArgs>
+  friend class tForwardedRequest;
+
   template <typename TReturn>
   friend class tRPCResponse;
 
   template <typename ... TArgs>
   friend class tRPCMessage;
 
+  friend class tForwardedMessage;
   friend class tRPCPort;
+  friend class tPendingCallTable;
+  friend class tTimerWheel;
 
-  /*! Global buffer pool with storage objects (TODO: possibly optimize if this becomes a bottle-neck) */
-  static tCallStorageBufferPool call_storage_buffer_pool;
+  template <typename T, typename TCallable>
+  friend class tContinuation;
 
-  /*! Is currently a call stored in this object? */
-  bool empty;
+  template <typename TInterface, typename TFunction, typename TReturn, typename ... TArgs>
+  friend class tServerCall;
+
+  /*! Flag in future_status that is set while a thread is waiting for completion */
+  enum { cWAITER_FLAG = 0x100, cSTATUS_MASK = cWAITER_FLAG - 1 };
+
+  /*! Alignment of call memory */
+  enum { cMEMORY_ALIGNMENT = 8 };
+
+  /*! Offset of inline memory relative to start of object (objects are allocated with inline memory directly behind them) */
+  static const size_t cINLINE_MEMORY_OFFSET;
 
-  /*! Mutex for thread synchronization */
-  rrlib::thread::tMutex mutex;
+  /*! Thread-local cache of unused storage objects (defined in tCallStorage.cpp) */
+  class tThreadLocalCache;
 
-  /*! Condition variable for thread synchronization */
-  std::condition_variable condition_variable;
+  /*! Global buffer pools with storage objects - one for each size class (accessed via thread-local caches) */
+  static tCallStorageBufferPool call_storage_buffer_pools[static_cast<size_t>(tSizeClass::DIMENSION)];
 
-  /*! True while thread is waiting on condition variable */
-  bool waiting;
+  /*! Cache of unused storage objects of the current thread */
+  static thread_local tThreadLocalCache thread_local_cache;
 
-  /*! Status for future */
+  /*! Function that sends calls collected by the current thread (set by tRPCPort while thread has an active batch scope - NULL otherwise) */
+  static thread_local void (*flush_collected_calls_hook)();
+
+  /*! Is currently a call stored in this object? */
+  bool empty;
+
+  /*!
+   * Status for future (tFutureStatus in lower bits) - combined with cWAITER_FLAG.
+   * Threads waiting for completion block on this word (futex).
+   */
   //std::atomic<tFutureStatus> future_status; // TODO: not supported by gcc 4.6 yet
   std::atomic<int> future_status;
 
@@ -334,8 +577,8 @@ private:
   /*! Reference counter on this storage */
   std::atomic<int> reference_counter;
 
-  /*! Pointer to (optional) response handler */
-  tAbstractResponseHandler* response_handler;
+  /*! Pointer to (optional) response handler (removed from this object when call completes) */
+  std::atomic<tAbstractResponseHandler*> response_handler;
 
   /*!
    * Does this contain a call that expects a response?
@@ -343,6 +586,12 @@ private:
    */
   rrlib::time::tDuration response_timeout;
 
+  /*!
+   * Deadline of call (tDeadline::max() if there is none).
+   * Sent to other processes as remaining time - as monotonic clocks of different machines are not comparable.
+   */
+  tDeadline deadline;
+
   /*! Identification of call in this process */
   tCallId call_id;
 
@@ -355,12 +604,35 @@ private:
   /*! Handle of remote port that call is meant for: Custom variable for network transport implementation */
   tHandle remote_port_handle;
 
-  /*! Call class storage memory */
-  union
-  {
-    unsigned char storage_memory[cSTORAGE_SIZE];
-    int64_t storage_memory64; // for 8-byte-alignment
-  };
+  /*! Size class of this storage object */
+  const tSizeClass size_class;
+
+  /*! Is call currently in timer wheel - and has neither expired nor been removed? (the following fields are only accessed by the wheel's thread) */
+  std::atomic<bool> in_timer_wheel;
+
+  /*! Neighbours in slot list of timer wheel (timer_wheel_next also links calls in the wheel's queue of added calls) */
+  tCallStorage* timer_wheel_next, * timer_wheel_prev;
+
+  /*! Next call in the wheel's queue of removed calls */
+  tCallStorage* timer_wheel_next_removed;
+
+  /*! Head of slot list in timer wheel that call is in */
+  tCallStorage** timer_wheel_slot;
+
+  /*! Tick of timer wheel at which call expires */
+  uint64_t timer_wheel_tick;
+
+  /*! Has wheel's thread processed addition of call (and not released call yet)? */
+  bool timer_wheel_added;
+
+  /*! Memory that currently stored call was created in (inline or heap memory) */
+  void* storage_memory;
+
+  /*! Heap memory for calls that do not fit into inline memory (allocated on demand and retained) */
+  std::unique_ptr<int64_t[]> heap_memory;
+
+  /*! Size of heap memory in bytes */
+  size_t heap_memory_size;
 
   /*!
    * \return Smart pointer to use inside tFuture
@@ -375,12 +647,64 @@ private:
   }
 
   /*!
-   * Helper function to check whether TCallClass fits into cSTORAGE_SIZE (with indication of required size in compiler output)
+   * Returns unused storage object to thread-local cache
+   * (or to global buffer pool if cache is full)
    */
-  template <size_t Tsize>
-  void CheckSize()
+  static void Recycle(tCallStorage* storage);
+
+  /*!
+   * Marks call as completed with the specified status and wakes up any thread waiting for completion.
+   * Caller must have written any result before.
+   * Only the first completion takes effect (e.g. a response might arrive while the call expires in the timer wheel).
+   *
+   * \param new_status New status (READY or an exception)
+   * \return Response handler that needs to be notified (NULL if none was set or call had already completed) - removed from this object
+   */
+  tAbstractResponseHandler* Complete(tFutureStatus new_status)
   {
-    static_assert(Tsize < cSTORAGE_SIZE, "Size of TCallClass is too big");
+    int old_state = future_status.load();
+    do
+    {
+      if ((old_state & cSTATUS_MASK) != static_cast<int>(tFutureStatus::PENDING))
+      {
+        return NULL;
+      }
+    }
+    while (!future_status.compare_exchange_weak(old_state, static_cast<int>(new_status)));
+    if (old_state & cWAITER_FLAG)
+    {
+      tFutex::Wake(future_status);
+    }
+    tAbstractResponseHandler* handler = response_handler.exchange(NULL);
+    if (in_timer_wheel.load())
+    {
+      tTimerWheel::Remove(*this); // wheel's thread releases its reference later
+    }
+    return handler;
+  }
+
+  /*!
+   * \param size_class Size class of storage object
+   * \return New storage object with inline memory of the specified size class
+   */
+  static tCallStorage* Create(tSizeClass size_class);
+
+  /*!
+   * \param size Required size in bytes
+   * \return Memory to create call of specified size in (inline memory if it fits - otherwise heap memory)
+   */
+  void* GetMemory(size_t size)
+  {
+    if (size <= GetInlineMemorySize(size_class))
+    {
+      return reinterpret_cast<char*>(this) + cINLINE_MEMORY_OFFSET;
+    }
+    if (size > heap_memory_size)
+    {
+      heap_memory_size = ((size + 1023) / 1024) * 1024;
+      heap_memory.reset(new int64_t[heap_memory_size / sizeof(int64_t)]);
+    }
+    return heap_memory.get();
   }
 };
 
@@ -0,0 +1,308 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/internal/tContinuation.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tContinuation
+ *
+ * \b tContinuation
+ *
+ * Continuation attached to a future via tFuture::Then().
+ * Stored in a tCallStorage object - together with the callable and the
+ * result of the continuation. Acts as response handler of the source
+ * future's call and invokes the callable in the thread that completes it.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__rpc_ports__internal__tContinuation_h__
+#define __plugins__rpc_ports__internal__tContinuation_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/tResponseHandler.h"
+#include "plugins/rpc_ports/tResult.h"
+#include "plugins/rpc_ports/internal/tCallStorage.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+class tIsFuture;
+
+/*!
+ * Determines value type of future returned by tFuture<T>::Then(TCallable).
+ * Callables returning a future are flattened (tFuture<tFuture<U>> becomes tFuture<U>).
+ */
+template <typename T, typename TCallable>
+struct tContinuationResult
+{
+  typedef decltype(std::declval<TCallable&>()(std::declval<T>())) tCallableResult;
+  static_assert(!std::is_same<tCallableResult, void>::value, "Continuations must return a value");
+
+  enum { cFLATTEN = std::is_base_of<tIsFuture, tCallableResult>::value };
+
+  template <typename U, bool FLATTEN>
+  struct tValue
+  {
+    typedef U type;
+  };
+
+  template <typename U>
+  struct tValue<U, true>
+  {
+    typedef typename U::tValue type;
+  };
+
+  typedef typename tValue<tCallableResult, cFLATTEN>::type type;
+};
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Future continuation
+/*!
+ * Continuation attached to a future via tFuture::Then().
+ * Stored in a tCallStorage object - together with the callable and the
+ * result of the continuation. Acts as response handler of the source
+ * future's call and invokes the callable in the thread that completes it.
+ *
+ * The continuation holds the (promise) pointer to its own storage until its result is set.
+ * Releasing this pointer deletes the continuation (unless the future for the result still exists).
+ *
+ * \tparam T Value type of source future
+ * \tparam TCallable Type of callable
+ */
+template <typename T, typename TCallable>
+class tContinuation : public tAbstractCall, public tResponseHandler<T>
+{
+  typedef typename tContinuationResult<T, TCallable>::type tValue;
+  enum { cFLATTEN = tContinuationResult<T, TCallable>::cFLATTEN };
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  template <typename TCallableArg>
+  tContinuation(tCallStorage& storage, tFuture<T> && source, TCallableArg && callable) :
+    storage(storage),
+    source(std::move(source)),
+    callable(std::forward<TCallableArg>(callable)),
+    result_buffer(),
+    inner_future(),
+    inner_handler(*this),
+    self()
+  {
+    storage.call_type = tCallType::UNSPECIFIED;
+    storage.future_status.store(static_cast<int>(tFutureStatus::PENDING));
+  }
+
+  /*!
+   * \return Future for result of this continuation
+   */
+  tFuture<tValue> GetFuture()
+  {
+    return tFuture<tValue>(storage.ObtainFuturePointer(), result_buffer);
+  }
+
+  /*!
+   * Invokes callable with result of source future
+   *
+   * \param callable Callable to invoke
+   * \param source_result Result of source future
+   * \return Future for result (with status of source future if source failed)
+   */
+  static tFuture<tValue> Invoke(TCallable& callable, tResult<T> && source_result)
+  {
+    if (!source_result.Ok())
+    {
+      return tFuture<tValue>(source_result.GetStatus());
+    }
+    try
+    {
+      return InvokeImplementation(callable, std::move(source_result.GetValue()));
+    }
+    catch (const tRPCException& e)
+    {
+      return tFuture<tValue>(e.GetType());
+    }
+    catch (const std::exception& e)
+    {
+      FINROC_LOG_PRINT_STATIC(WARNING, "Continuation threw exception: ", e);
+      return tFuture<tValue>(tFutureStatus::BROKEN_PROMISE);
+    }
+  }
+
+  /*!
+   * Attaches continuation to source future
+   * (after this call returns, continuation might already have been completed and deleted)
+   *
+   * \param self Pointer to this continuation's storage (held until result is set)
+   */
+  void Start(tCallStorage::tPointer && self)
+  {
+    this->self = std::move(self);
+    if (!source.storage->AttachResponseHandler(this))
+    {
+      Continue(source.TryGet(rrlib::time::tDuration::zero()));
+    }
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Response handler for futures returned by callable (flattened futures) */
+  class tInnerHandler : public tResponseHandler<tValue>
+  {
+  public:
+    tInnerHandler(tContinuation& continuation) : continuation(continuation) {}
+
+    virtual void HandleException(tFutureStatus exception_type) override
+    {
+      continuation.Finish(tResult<tValue>(exception_type));
+    }
+
+    virtual void HandleResponse(tValue call_result) override
+    {
+      continuation.Finish(tResult<tValue>(std::move(call_result)));
+    }
+
+  private:
+    tContinuation& continuation;
+  };
+
+  /*! Storage this continuation was allocated in */
+  tCallStorage& storage;
+
+  /*! Future that this continuation is attached to */
+  tFuture<T> source;
+
+  /*! Callable to invoke with result */
+  TCallable callable;
+
+  /*! Result will be stored here */
+  tValue result_buffer;
+
+  /*! Pending future returned by callable (flattened futures) */
+  tFuture<tValue> inner_future;
+
+  /*! Response handler for inner_future */
+  tInnerHandler inner_handler;
+
+  /*! Pointer to own storage (held until result is set) */
+  tCallStorage::tPointer self;
+
+
+  template <bool FLATTEN = cFLATTEN>
+  static typename std::enable_if<FLATTEN, tFuture<tValue>>::type InvokeImplementation(TCallable& callable, T && value)
+  {
+    return callable(std::move(value));
+  }
+
+  template <bool DISABLE = cFLATTEN>
+  static typename std::enable_if < !DISABLE, tFuture<tValue >>::type InvokeImplementation(TCallable& callable, T && value)
+  {
+    return tFuture<tValue>(tFutureStatus::READY, callable(std::move(value)));
+  }
+
+  /*!
+   * Invokes callable and forwards its result to future of this continuation
+   */
+  void Continue(tResult<T> && source_result)
+  {
+    tFuture<tValue> next = Invoke(callable, std::move(source_result));
+    if (!next.storage)
+    {
+      Finish(next.TryGet(rrlib::time::tDuration::zero()));
+      return;
+    }
+    inner_future = std::move(next);
+    if (!inner_future.storage->AttachResponseHandler(&inner_handler))
+    {
+      Finish(inner_future.TryGet(rrlib::time::tDuration::zero()));
+    }
+  }
+
+  /*!
+   * Sets result of this continuation and releases its storage
+   * (continuation might be deleted when this method returns)
+   */
+  void Finish(tResult<tValue> && result)
+  {
+    tCallStorage::tPointer self_pointer = std::move(self);
+    if (!result.Ok())
+    {
+      storage.SetException(result.GetStatus());
+      return;
+    }
+    result_buffer = std::move(result.GetValue());
+    tAbstractResponseHandler* handler = storage.Complete(tFutureStatus::READY);
+    if (handler)
+    {
+      static_cast<tResponseHandler<tValue>*>(handler)->HandleResponse(std::move(result_buffer));
+    }
+  }
+
+  virtual void HandleException(tFutureStatus exception_type) override
+  {
+    Continue(tResult<T>(exception_type));
+  }
+
+  virtual void HandleResponse(T call_result) override
+  {
+    Continue(tResult<T>(std::move(call_result)));
+  }
+
+  virtual void Serialize(rrlib::serialization::tOutputStream& stream, tWireFormat& wire_format) override
+  {
+    throw std::runtime_error("Continuations cannot be serialized");
+  }
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -0,0 +1,155 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/internal/tForwardedMessage.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tForwardedMessage
+ *
+ * \b tForwardedMessage
+ *
+ * RPC message that is forwarded to another network port without deserializing its parameters.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__rpc_ports__internal__tForwardedMessage_h__
+#define __plugins__rpc_ports__internal__tForwardedMessage_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/tRPCBuffer.h"
+#include "plugins/rpc_ports/internal/tAbstractCall.h"
+#include "plugins/rpc_ports/internal/tCallStorage.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Forwarded RPC message
+/*!
+ * RPC message that a routing runtime environment forwards from one network connection to another.
+ * The serialized parameters are kept as opaque bytes and written unchanged - only the header is rewritten
+ * (see tRPCInterfaceTypeInfo::ForwardMessage()).
+ */
+class tForwardedMessage : public tAbstractCall
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * \param storage Storage this message is allocated in
+   * \param rpc_interface_type RPC interface type
+   * \param function_index Index of function in interface
+   * \param parameters Serialized parameters
+   * \param source_wire_format Wire format of the connection the parameters were received from
+   */
+  tForwardedMessage(tCallStorage& storage, const rrlib::rtti::tType& rpc_interface_type, uint8_t function_index, tRPCBuffer && parameters, const tWireFormat& source_wire_format) :
+    rpc_interface_type(rpc_interface_type),
+    function_index(function_index),
+    parameters(std::move(parameters)),
+    source_encoding(source_wire_format.GetEncoding()),
+    source_raw_blocks(source_wire_format.RawBlocksEnabled())
+  {
+    storage.call_type = tCallType::RPC_MESSAGE;
+  }
+
+  /*!
+   * Checks whether serialized parameters can be written unchanged to a connection
+   * (called before anything is written to the stream - so that nothing is left half-written and no interface type is registered)
+   *
+   * \throw std::runtime_error if wire format of target connection encodes parameters differently
+   */
+  static void CheckParameterEncoding(tWireFormat::tEncoding source_encoding, bool source_raw_blocks, const tWireFormat& wire_format)
+  {
+    if (wire_format.GetEncoding() != source_encoding || wire_format.RawBlocksEnabled() != source_raw_blocks)
+    {
+      throw std::runtime_error("Forwarded parameters were serialized for a connection with different wire format");
+    }
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! RPC Interface Type */
+  rrlib::rtti::tType rpc_interface_type;
+
+  /*! Index of function in interface */
+  uint8_t function_index;
+
+  /*! Serialized parameters */
+  tRPCBuffer parameters;
+
+  /*! Encoding of connection the parameters were received from */
+  tWireFormat::tEncoding source_encoding;
+
+  /*! Were raw blocks enabled on connection the parameters were received from? */
+  bool source_raw_blocks;
+
+
+  virtual void Serialize(rrlib::serialization::tOutputStream& stream, tWireFormat& wire_format) override
+  {
+    CheckParameterEncoding(source_encoding, source_raw_blocks, wire_format);
+
+    // Deserialized by network transport implementation
+    wire_format.WriteInterfaceType(stream, rpc_interface_type);
+    stream << function_index;
+
+    // Deserialized by tRPCMessage of receiver
+    wire_format.WriteOpaqueBytes(stream, parameters);
+  }
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -0,0 +1,182 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/internal/tForwardedRequest.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tForwardedRequest
+ *
+ * \b tForwardedRequest
+ *
+ * RPC request that is forwarded to another network port without deserializing its parameters.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__rpc_ports__internal__tForwardedRequest_h__
+#define __plugins__rpc_ports__internal__tForwardedRequest_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/internal/tForwardedMessage.h"
+#include "plugins/rpc_ports/internal/tRPCRequest.h"
+#include "plugins/rpc_ports/internal/tResponseSender.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Forwarded RPC request
+/*!
+ * RPC request that a routing runtime environment forwards from one network connection to another.
+ * The serialized parameters are kept as opaque bytes and written unchanged - only the header
+ * (interface type, call id and remaining time) is rewritten.
+ * The response is handled like the response to any other request.
+ */
+template <typename TReturn, typename ... TArgs>
+class tForwardedRequest : public tRPCRequest<TReturn, TArgs...>
+{
+  typedef tRPCRequest<TReturn, TArgs...> tBase;
+  typedef typename tBase::tResponseFuture tResponseFuture;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * \param storage Storage this request is allocated in
+   * \param server_port Network port to forward request to
+   * \param function_index Index of function in interface
+   * \param timeout Remaining time until deadline of caller
+   * \param parameters Serialized parameters
+   * \param source_wire_format Wire format of the connection the parameters were received from
+   */
+  tForwardedRequest(tCallStorage& storage, tRPCPort& server_port, uint8_t function_index, const rrlib::time::tDuration& timeout,
+                    tRPCBuffer && parameters, const tWireFormat& source_wire_format) :
+    tBase(storage, server_port, function_index, timeout),
+    serialized_parameters(std::move(parameters)),
+    source_encoding(source_wire_format.GetEncoding()),
+    source_raw_blocks(source_wire_format.RawBlocksEnabled())
+  {}
+
+  static void ForwardCallImplementation(tRPCPort& port, uint8_t function_id, tCallId remote_call_id, const rrlib::time::tDuration& timeout,
+                                        tRPCBuffer && parameters, tResponseSender& response_sender, const tWireFormat& wire_format)
+  {
+    typedef tRPCResponse<tResponseFuture> tResponse;
+    typename tCallStorage::tPointer call_storage = tCallStorage::GetUnused<tResponse>();
+    tResponse& response = call_storage->Emplace<tResponse>(*call_storage, port.GetDataType(), function_id, timeout);
+    response.SetCallId(remote_call_id);
+    call_storage->local_port_handle = port.GetHandle();
+    tRPCPort* server_port = port.GetServer(true);
+    if (timeout <= rrlib::time::tDuration::zero())
+    {
+      // Deadline has passed already: nobody is waiting for the result anymore
+      response.SetReturnValue(tResponseFuture(tFutureStatus::TIMEOUT));
+    }
+    else if (!server_port)
+    {
+      response.SetReturnValue(tResponseFuture(tFutureStatus::NO_CONNECTION));
+    }
+    else if (server_port->GetCallHandler())
+    {
+      FINROC_LOG_PRINT_STATIC(WARNING, "Requests can only be forwarded to network ports");
+      response.SetReturnValue(tResponseFuture(tFutureStatus::INVALID_CALL));
+    }
+    else
+    {
+      typename tCallStorage::tPointer request_storage = tCallStorage::GetUnused<tForwardedRequest>();
+      tForwardedRequest& request = request_storage->Emplace<tForwardedRequest>(*request_storage, *server_port, function_id, timeout, std::move(parameters), wire_format);
+      response.SetReturnValue(request.GetFuture());
+      server_port->SendCall(request_storage);
+    }
+    response_sender.SendResponse(call_storage);
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Serialized parameters */
+  tRPCBuffer serialized_parameters;
+
+  /*! Encoding of connection the parameters were received from */
+  tWireFormat::tEncoding source_encoding;
+
+  /*! Were raw blocks enabled on connection the parameters were received from? */
+  bool source_raw_blocks;
+
+
+  virtual void Serialize(rrlib::serialization::tOutputStream& stream, tWireFormat& wire_format) override
+  {
+    tForwardedMessage::CheckParameterEncoding(source_encoding, source_raw_blocks, wire_format);
+
+    // Deserialized by network transport implementation
+    wire_format.WriteInterfaceType(stream, this->rpc_interface_type);
+    stream << this->function_index;
+
+    // Deserialized by tRPCRequest of receiver
+    wire_format.WriteCallId(stream, this->storage.GetCallId());
+    wire_format.WriteTimeout(stream, this->storage.RemainingTime());
+    wire_format.WriteOpaqueBytes(stream, serialized_parameters);
+  }
+};
+
+struct tNoForwardedRequest
+{
+  static void ForwardCallImplementation(tRPCPort& port, uint8_t function_id, tCallId remote_call_id, const rrlib::time::tDuration& timeout,
+                                        tRPCBuffer && parameters, tResponseSender& response_sender, const tWireFormat& wire_format)
+  {
+    throw std::runtime_error("Not supported for functions returning void");
+  }
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
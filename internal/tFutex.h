@@ -0,0 +1,141 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/internal/tFutex.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tFutex
+ *
+ * \b tFutex
+ *
+ * Wait/wake operations on atomic integers (Linux futexes).
+ * Allows threads to block on the same atomic word that is used
+ * to signal completion - without mutex or condition variable.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__rpc_ports__internal__tFutex_h__
+#define __plugins__rpc_ports__internal__tFutex_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <atomic>
+#include <cstdint>
+#include "rrlib/time/time.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+/*!
+ * Count Wake() operations for tests and diagnostics (see tFutex::GetWakeCount())?
+ * Enabled in debug builds only - as the counter is shared by all threads that complete calls.
+ */
+#if !defined(NDEBUG) && !defined(FINROC_RPC_PORTS_COUNT_WAKE_UPS)
+#define FINROC_RPC_PORTS_COUNT_WAKE_UPS
+#endif
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Futex operations
+/*!
+ * Wait/wake operations on atomic integers (Linux futexes).
+ * Allows threads to block on the same atomic word that is used
+ * to signal completion - without mutex or condition variable.
+ */
+class tFutex
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * Blocks calling thread as long as 'word' contains 'expected_value'.
+   * May return spuriously - so callers need to check the value of 'word' afterwards.
+   *
+   * \param word Atomic word to wait on
+   * \param expected_value Value that 'word' is expected to have
+   * \param timeout Maximum time to block
+   */
+  static void Wait(std::atomic<int>& word, int expected_value, const rrlib::time::tDuration& timeout);
+
+  /*!
+   * Wakes up threads blocked in Wait() on the specified word
+   *
+   * \param word Atomic word that threads wait on
+   * \param thread_count Maximum number of threads to wake up
+   */
+  static void Wake(std::atomic<int>& word, int thread_count = 1);
+
+#ifdef FINROC_RPC_PORTS_COUNT_WAKE_UPS
+  /*!
+   * \return Number of Wake() operations performed so far (by all threads - e.g. for tests and profiling)
+   */
+  static uint64_t GetWakeCount()
+  {
+    return wake_count.load(std::memory_order_relaxed);
+  }
+#endif
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  static_assert(sizeof(std::atomic<int>) == sizeof(int), "Futex operations require lock-free atomic integers");
+
+#ifdef FINROC_RPC_PORTS_COUNT_WAKE_UPS
+  /*! Number of Wake() operations performed so far */
+  static std::atomic<uint64_t> wake_count;
+#endif
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
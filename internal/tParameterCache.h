@@ -0,0 +1,187 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/internal/tParameterCache.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tParameterCache
+ *
+ * \b tParameterCache
+ *
+ * Thread-local parameter tuples that incoming calls are deserialized into.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__rpc_ports__internal__tParameterCache_h__
+#define __plugins__rpc_ports__internal__tParameterCache_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tIntegerSequence.h"
+#include "rrlib/util/tNoncopyable.h"
+#include <memory>
+#include <tuple>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/tRPCBuffer.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Cache for parameter tuples of incoming calls
+/*!
+ * Every thread has one parameter tuple per RPC interface and function signature
+ * that incoming calls are deserialized into - instead of a newly constructed tuple.
+ * Values are overwritten in place by the next call, so that e.g. strings and vectors
+ * keep the capacity of their heap buffers and do not need to reallocate.
+ * (Functions with the same signature in the same interface share a tuple.)
+ *
+ * Nested use of the same cache in one thread is possible: it falls back to a separately allocated tuple.
+ * tRPCBuffer values are released after each call - so that the cache does not keep receive buffers alive.
+ *
+ * \tparam TParameterTuple Type of parameter tuple
+ * \tparam TInterface RPC interface type
+ * \tparam TFunction Function type
+ */
+template <typename TParameterTuple, typename TInterface, typename TFunction>
+class tParameterCache : private rrlib::util::tNoncopyable
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * Obtains this thread's parameter tuple (for the lifetime of this object)
+   */
+  tParameterCache() :
+    entry(thread_entry),
+    borrowed(!entry.in_use),
+    fallback()
+  {
+    if (borrowed)
+    {
+      entry.in_use = true;
+    }
+    else
+    {
+      fallback.reset(new TParameterTuple());
+    }
+  }
+
+  ~tParameterCache()
+  {
+    if (borrowed)
+    {
+      ReleaseValues(entry.parameters, typename rrlib::util::tIntegerSequenceGenerator<std::tuple_size<TParameterTuple>::value>::type());
+      entry.in_use = false;
+    }
+  }
+
+  /*!
+   * \return Parameter tuple to deserialize call into (contains values of a previous call)
+   */
+  TParameterTuple& Get()
+  {
+    return borrowed ? entry.parameters : *fallback;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Cached tuple of one thread */
+  struct tEntry
+  {
+    /*! Cached parameter tuple */
+    TParameterTuple parameters;
+
+    /*! Is tuple currently in use? */
+    bool in_use;
+
+    tEntry() : parameters(), in_use(false) {}
+  };
+
+  /*! Cached tuple of current thread */
+  static thread_local tEntry thread_entry;
+
+  /*! Cached tuple of current thread */
+  tEntry& entry;
+
+  /*! Does this object use the cached tuple? */
+  bool borrowed;
+
+  /*! Tuple used if cached tuple is already in use */
+  std::unique_ptr<TParameterTuple> fallback;
+
+
+  template <int ... SEQUENCE>
+  static void ReleaseValues(TParameterTuple& parameters, rrlib::util::tIntegerSequence<SEQUENCE...> sequence)
+  {
+    int release[] = { 0, (ReleaseValue(std::get<SEQUENCE>(parameters)), 0)... };
+    (void)release;
+  }
+
+  template <typename T>
+  static void ReleaseValue(T& value)
+  {}
+
+  static void ReleaseValue(tRPCBuffer& value)
+  {
+    value = tRPCBuffer();
+  }
+};
+
+template <typename TParameterTuple, typename TInterface, typename TFunction>
+thread_local typename tParameterCache<TParameterTuple, TInterface, TFunction>::tEntry tParameterCache<TParameterTuple, TInterface, TFunction>::thread_entry;
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
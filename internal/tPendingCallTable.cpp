@@ -0,0 +1,212 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/internal/tPendingCallTable.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/internal/tPendingCallTable.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+namespace
+{
+
+/*! Number of threads that have inserted calls into pending call tables (used to assign slot blocks to threads) */
+std::atomic<size_t> thread_count(0);
+
+/*!
+ * Slot block of current thread (threads start searching for free slots in different blocks -
+ * so concurrent inserts by different threads do not contend for the same cache lines)
+ */
+thread_local size_t thread_slot_block = thread_count.fetch_add(1, std::memory_order_relaxed);
+
+/*! Position in thread's slot block at which current thread continues searching for a free slot */
+thread_local size_t thread_slot_cursor = 0;
+
+}
+
+tPendingCallTable::tPendingCallTable(size_t capacity) :
+  slots(),
+  index_bits(GetIndexBits(capacity)),
+  index_mask((1ull << index_bits) - 1),
+  generation_mask((~0ull) >> index_bits)
+{
+  slots.reset(new tSlot[index_mask + 1]);
+}
+
+tPendingCallTable::~tPendingCallTable()
+{
+  Clear(tFutureStatus::NO_CONNECTION);
+}
+
+void tPendingCallTable::Clear(tFutureStatus status)
+{
+  for (size_t i = 0; i <= index_mask; i++)
+  {
+    tSlot& slot = slots[i];
+    uint64_t tag = slot.tag.load();
+    if ((tag & cSTATE_MASK) == cOCCUPIED)
+    {
+      tRPCPort::tCallPointer call = TakeFromSlot(slot, tag, slot.call.load());
+      if (call && call->GetFutureStatus() == tFutureStatus::PENDING)
+      {
+        call->SetException(status);
+      }
+    }
+  }
+}
+
+tCallStorage::tFuturePointer tPendingCallTable::Insert(tRPCPort::tCallPointer && call)
+{
+  size_t block_start = (thread_slot_block * cSLOTS_PER_THREAD) & index_mask;
+  size_t start = block_start + thread_slot_cursor;
+  for (size_t i = 0; i <= index_mask; i++)
+  {
+    size_t index = (start + i) & index_mask;
+    tSlot& slot = slots[index];
+    uint64_t tag = slot.tag.load(std::memory_order_relaxed);
+    if ((tag & cSTATE_MASK) != cFREE)
+    {
+      continue;
+    }
+    uint64_t generation = ((tag >> cSTATE_BITS) + 1) & generation_mask;
+    generation = generation ? generation : 1; // call id 0 is never assigned
+    if (!slot.tag.compare_exchange_strong(tag, (generation << cSTATE_BITS) | cRESERVED))
+    {
+      continue;
+    }
+
+    tCallId call_id = (generation << index_bits) | index;
+    call->SetCallId(call_id);
+    tCallStorage::tFuturePointer reference = call->ObtainFuturePointer(); // obtained before call is visible to other threads
+    slot.call.store(call.release(), std::memory_order_relaxed);
+    slot.tag.store((generation << cSTATE_BITS) | cOCCUPIED, std::memory_order_release);
+    size_t block_offset = (index - block_start) & index_mask;
+    if (block_offset < cSLOTS_PER_THREAD)
+    {
+      thread_slot_cursor = (block_offset + 1) % cSLOTS_PER_THREAD;
+    }
+    return reference;
+  }
+  throw std::runtime_error("Pending call table is full");
+}
+
+uint32_t tPendingCallTable::GetIndexBits(size_t capacity)
+{
+  uint32_t bits = cMIN_INDEX_BITS;
+  while ((1ull << bits) < capacity)
+  {
+    bits++;
+  }
+  return bits;
+}
+
+size_t tPendingCallTable::RemoveCompleted()
+{
+  size_t removed = 0;
+  for (size_t i = 0; i <= index_mask; i++)
+  {
+    tSlot& slot = slots[i];
+    uint64_t tag = slot.tag.load(std::memory_order_acquire);
+    if ((tag & cSTATE_MASK) != cOCCUPIED)
+    {
+      continue;
+    }
+
+    // Call might be removed and recycled concurrently: storage objects are never deallocated while
+    // they are in use by the framework, so reading status is safe - and the tag check in TakeFromSlot() fails then
+    tCallStorage* call = slot.call.load(std::memory_order_relaxed);
+    if (call->GetFutureStatus() != tFutureStatus::PENDING && TakeFromSlot(slot, tag, call))
+    {
+      removed++;
+    }
+  }
+  return removed;
+}
+
+tRPCPort::tCallPointer tPendingCallTable::Take(tCallId call_id)
+{
+  tSlot& slot = slots[call_id & index_mask];
+  uint64_t tag = ((call_id >> index_bits) << cSTATE_BITS) | cOCCUPIED;
+  if (slot.tag.load(std::memory_order_acquire) != tag)
+  {
+    return tRPCPort::tCallPointer();
+  }
+  return TakeFromSlot(slot, tag, slot.call.load(std::memory_order_relaxed));
+}
+
+tRPCPort::tCallPointer tPendingCallTable::TakeFromSlot(tSlot& slot, uint64_t tag, tCallStorage* call)
+{
+  if (slot.tag.compare_exchange_strong(tag, (tag & ~static_cast<uint64_t>(cSTATE_MASK)) | cFREE))
+  {
+    return tRPCPort::tCallPointer(call);
+  }
+  return tRPCPort::tCallPointer();
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
@@ -0,0 +1,220 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/internal/tPendingCallTable.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tPendingCallTable
+ *
+ * \b tPendingCallTable
+ *
+ * Table with calls that were sent to another runtime environment and await a response.
+ * Meant to be used by network transports to match incoming responses to their requests.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__rpc_ports__internal__tPendingCallTable_h__
+#define __plugins__rpc_ports__internal__tPendingCallTable_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tNoncopyable.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/internal/tRPCPort.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Table with pending calls
+/*!
+ * Table with calls that were sent to another runtime environment and await a response.
+ * Meant to be used by network transports to match incoming responses to their requests
+ * (typically one table per connection).
+ *
+ * The table takes ownership of the calls it contains - so they cannot be recycled before
+ * the response has been handled. Transports keep an additional reference while they serialize a call (see Insert()). Calls are assigned call ids when they are inserted.
+ * Call ids contain the index of the call's slot and the slot's generation:
+ * Slots are searched by open addressing when calls are inserted, while responses are matched in O(1)
+ * (call ids are direct indexes into the table) and responses to calls that have been removed already
+ * (e.g. late or duplicate responses) are detected safely.
+ *
+ * Each thread starts searching for free slots in its own block of cSLOTS_PER_THREAD slots -
+ * so that threads inserting calls concurrently do not contend for the same cache lines.
+ *
+ * All operations are lock-free.
+ */
+class tPendingCallTable : private rrlib::util::tNoncopyable
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * \param capacity Maximum number of pending calls (rounded up to power of two)
+   */
+  explicit tPendingCallTable(size_t capacity = 4096);
+
+  /*! Completes any calls left in table with tFutureStatus::NO_CONNECTION */
+  ~tPendingCallTable();
+
+  /*!
+   * \return Maximum number of pending calls
+   */
+  size_t Capacity() const
+  {
+    return index_mask + 1;
+  }
+
+  /*!
+   * \param call_id Call id assigned by this table
+   * \return Index of slot that call with specified id is stored in
+   */
+  size_t GetSlotIndex(tCallId call_id) const
+  {
+    return call_id & index_mask;
+  }
+
+  /*!
+   * Removes all calls from table
+   *
+   * \param status Exception to complete calls with that are still pending (e.g. NO_CONNECTION when connection was closed)
+   */
+  void Clear(tFutureStatus status);
+
+  /*!
+   * Inserts call into table and assigns call id to it
+   * (must be called before call is serialized - as call id is part of serialized call)
+   * Throws std::runtime_error if table is full.
+   *
+   * As soon as the call is in the table, it may be completed (e.g. timed out) and removed by other threads.
+   * Therefore, the transport obtains a separate reference to the call:
+   * it serializes the call via this reference - and releases it afterwards.
+   *
+   * \param call Call to insert
+   * \return Reference to inserted call that keeps it from being recycled (call id is available via GetCallId())
+   */
+  tCallStorage::tFuturePointer Insert(tRPCPort::tCallPointer && call);
+
+  /*!
+   * Removes calls that have completed (e.g. timed out) from table
+   * (should be called regularly by transports - e.g. in their send loops)
+   *
+   * \return Number of calls removed
+   */
+  size_t RemoveCompleted();
+
+  /*!
+   * Removes call with specified call id from table
+   * (typically called when a response arrives: the returned call is passed to tRPCInterfaceTypeInfo::DeserializeResponse())
+   *
+   * \param call_id Call id
+   * \return Call with specified id. Empty pointer if there is no such call (anymore).
+   */
+  tRPCPort::tCallPointer Take(tCallId call_id);
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! States of slots (lower bits of slot tag - the upper bits contain the slot's generation) */
+  enum { cFREE = 0, cRESERVED = 1 /* call is currently being inserted */, cOCCUPIED = 2, cSTATE_BITS = 2, cSTATE_MASK = (1 << cSTATE_BITS) - 1 };
+
+  /*! Number of slots in each thread's slot block */
+  enum { cSLOTS_PER_THREAD = 64 };
+
+  /*! Minimum number of bits for slot index (so that generations in call ids also fit into slot tags) */
+  enum { cMIN_INDEX_BITS = cSTATE_BITS };
+
+  /*! Slot in table */
+  struct tSlot
+  {
+    /*! State and generation of slot (generation is incremented whenever a call is inserted) */
+    std::atomic<uint64_t> tag;
+
+    /*! Call in slot (valid while slot is occupied) */
+    std::atomic<tCallStorage*> call;
+
+    tSlot() : tag(cFREE), call(NULL) {}
+  };
+
+  /*! Slots of table */
+  std::unique_ptr<tSlot[]> slots;
+
+  /*! Number of bits of call ids that contain slot index */
+  const uint32_t index_bits;
+
+  /*! Mask for slot index (capacity - 1) */
+  const uint64_t index_mask;
+
+  /*! Mask for generations (generations are wrapped so that they fit into call ids) */
+  const uint64_t generation_mask;
+
+
+  /*!
+   * \param capacity Requested capacity
+   * \return Number of bits required for slot index
+   */
+  static uint32_t GetIndexBits(size_t capacity);
+
+  /*!
+   * Removes call from slot if slot contains call with specified tag
+   *
+   * \param slot Slot
+   * \param tag Expected tag of slot
+   * \param call Call in slot (must have been read after tag)
+   * \return Call if it was removed - otherwise empty pointer
+   */
+  tRPCPort::tCallPointer TakeFromSlot(tSlot& slot, uint64_t tag, tCallStorage* call);
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -37,6 +37,8 @@
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "plugins/rpc_ports/internal/tForwardedMessage.h"
+#include "plugins/rpc_ports/internal/tRPCPort.h"
 
 //----------------------------------------------------------------------
 // Debugging
@@ -74,11 +76,11 @@ tRPCInterfaceTypeInfo::tRPCInterfaceTypeInfo() :
   methods()
 {}
 
-void tRPCInterfaceTypeInfo::DeserializeMessage(rrlib::serialization::tInputStream& stream, tRPCPort& port, uint8_t function_id)
+void tRPCInterfaceTypeInfo::DeserializeMessage(rrlib::serialization::tInputStream& stream, tRPCPort& port, uint8_t function_id, const tWireFormat& wire_format)
 {
   if (function_id < methods.size())
   {
-    (*methods[function_id].deserialize_message)(stream, port, function_id);
+    (*methods[function_id].deserialize_message)(stream, port, function_id, wire_format);
   }
   else
   {
@@ -86,11 +88,52 @@ void tRPCInterfaceTypeInfo::DeserializeMessage(rrlib::serialization::tInputStrea
   }
 }
 
-void tRPCInterfaceTypeInfo::DeserializeRequest(rrlib::serialization::tInputStream& stream, tRPCPort& port, uint8_t function_id, tResponseSender& response_sender)
+bool tRPCInterfaceTypeInfo::ForwardMessage(tRPCPort& port, uint8_t function_id, tRPCBuffer && parameters, const tWireFormat& wire_format)
+{
+  if (function_id >= methods.size())
+  {
+    FINROC_LOG_PRINT(ERROR, "Invalid function id");
+    return true;
+  }
+  tRPCPort* server_port = GetForwardingTarget(port, wire_format);
+  if (!server_port)
+  {
+    return false;
+  }
+  typename tCallStorage::tPointer call_storage = tCallStorage::GetUnused<tForwardedMessage>();
+  call_storage->Emplace<tForwardedMessage>(*call_storage, server_port->GetDataType(), function_id, std::move(parameters), wire_format);
+  server_port->SendCall(call_storage);
+  return true;
+}
+
+bool tRPCInterfaceTypeInfo::ForwardRequest(tRPCPort& port, uint8_t function_id, tCallId remote_call_id, const rrlib::time::tDuration& timeout,
+    tRPCBuffer && parameters, tResponseSender& response_sender, const tWireFormat& wire_format)
+{
+  if (function_id >= methods.size())
+  {
+    FINROC_LOG_PRINT(ERROR, "Invalid function id");
+    return true;
+  }
+  if (!GetForwardingTarget(port, wire_format))
+  {
+    return false;
+  }
+  (*methods[function_id].forward_request)(port, function_id, remote_call_id, timeout, std::move(parameters), response_sender, wire_format);
+  return true;
+}
+
+tRPCPort* tRPCInterfaceTypeInfo::GetForwardingTarget(tRPCPort& port, const tWireFormat& wire_format)
+{
+  tRPCPort* server_port = port.GetServer(true);
+  return (server_port && (!server_port->GetCallHandler()) && server_port->AcceptsForwardedParameters(wire_format)) ? server_port : NULL;
+}
+
+void tRPCInterfaceTypeInfo::DeserializeRequest(rrlib::serialization::tInputStream& stream, tRPCPort& port, uint8_t function_id, tResponseSender& response_sender,
+    const tWireFormat& wire_format)
 {
   if (function_id < methods.size())
   {
-    (*methods[function_id].deserialize_request)(stream, port, function_id, response_sender);
+    (*methods[function_id].deserialize_request)(stream, port, function_id, response_sender, wire_format);
   }
   else
   {
@@ -98,11 +141,12 @@ void tRPCInterfaceTypeInfo::DeserializeRequest(rrlib::serialization::tInputStrea
   }
 }
 
-void tRPCInterfaceTypeInfo::DeserializeResponse(rrlib::serialization::tInputStream& stream, uint8_t function_id, tResponseSender& response_sender, tCallStorage* request_storage)
+void tRPCInterfaceTypeInfo::DeserializeResponse(rrlib::serialization::tInputStream& stream, uint8_t function_id, tResponseSender& response_sender, tCallStorage* request_storage,
+    const tWireFormat& wire_format)
 {
   if (function_id < methods.size())
   {
-    (*methods[function_id].deserialize_response)(stream, this->GetAnnotatedType(), function_id, response_sender, request_storage);
+    (*methods[function_id].deserialize_response)(stream, this->GetAnnotatedType(), function_id, response_sender, request_storage, wire_format);
   }
   else
   {
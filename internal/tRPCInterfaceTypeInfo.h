@@ -46,6 +46,7 @@
 // Internal includes with ""
 //----------------------------------------------------------------------
 #include "plugins/rpc_ports/definitions.h"
+#include "plugins/rpc_ports/internal/tWireFormat.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -85,18 +86,66 @@ public:
 
   /*!
    * Deserializes message
+   *
+   * \param wire_format Wire format of the connection the message was received from
    */
-  void DeserializeMessage(rrlib::serialization::tInputStream& stream, tRPCPort& port, uint8_t function_id);
+  void DeserializeMessage(rrlib::serialization::tInputStream& stream, tRPCPort& port, uint8_t function_id, const tWireFormat& wire_format = tWireFormat::Legacy());
 
   /*!
    * Deserializes request
+   *
+   * \param wire_format Wire format of the connection the request was received from
    */
-  void DeserializeRequest(rrlib::serialization::tInputStream& stream, tRPCPort& port, uint8_t function_id, tResponseSender& response_sender);
+  void DeserializeRequest(rrlib::serialization::tInputStream& stream, tRPCPort& port, uint8_t function_id, tResponseSender& response_sender,
+                          const tWireFormat& wire_format = tWireFormat::Legacy());
+
+  /*!
+   * Forwards message to the network port that the specified port is connected to - without deserializing its parameters
+   * (for runtime environments that only route calls between network connections - see GetForwardingTarget()).
+   * Called by network transport implementation instead of DeserializeMessage() - after reading the header.
+   *
+   * \param port Port that received message
+   * \param function_id Index of function in interface
+   * \param parameters Serialized parameters (the remaining bytes of the message - not moved from if message is not forwarded)
+   * \param wire_format Wire format of the connection the message was received from
+   * \return False if message cannot be forwarded (see GetForwardingTarget()) - transport needs to call DeserializeMessage() with the parameters then
+   */
+  bool ForwardMessage(tRPCPort& port, uint8_t function_id, tRPCBuffer && parameters, const tWireFormat& wire_format);
+
+  /*!
+   * Forwards request to the network port that the specified port is connected to - without deserializing its parameters.
+   * Only the header is rewritten; the response is handled like the response of any other request.
+   * Called by network transport implementation instead of DeserializeRequest() - after reading the header
+   * including call id and timeout (with tWireFormat::ReadCallId() and tWireFormat::ReadTimeout()).
+   *
+   * \param port Port that received request
+   * \param function_id Index of function in interface
+   * \param remote_call_id Call id of request
+   * \param timeout Remaining time until deadline of caller
+   * \param parameters Serialized parameters (the remaining bytes of the request - not moved from if request is not forwarded)
+   * \param response_sender Response sender to return response to caller with
+   * \param wire_format Wire format of the connection the request was received from
+   * \return False if request cannot be forwarded (see GetForwardingTarget()) - transport needs to deserialize it with DeserializeRequest() then.
+   *         Transports may check GetForwardingTarget() before reading call id and timeout - and call DeserializeRequest() right away if there is no target.
+   */
+  bool ForwardRequest(tRPCPort& port, uint8_t function_id, tCallId remote_call_id, const rrlib::time::tDuration& timeout,
+                      tRPCBuffer && parameters, tResponseSender& response_sender, const tWireFormat& wire_format);
+
+  /*!
+   * \param port Port that received call
+   * \param wire_format Wire format of the connection the call was received from
+   * \return Network port that calls to port can be forwarded to without deserializing them
+   *         (NULL if port is connected to a local server or not at all - or if the network port cannot write the parameters unchanged to its connection)
+   */
+  static tRPCPort* GetForwardingTarget(tRPCPort& port, const tWireFormat& wire_format);
 
   /*!
    * Deserializes response
+   *
+   * \param wire_format Wire format of the connection the response was received from
    */
-  void DeserializeResponse(rrlib::serialization::tInputStream& stream, uint8_t function_id, tResponseSender& response_sender, tCallStorage* request_storage);
+  void DeserializeResponse(rrlib::serialization::tInputStream& stream, uint8_t function_id, tResponseSender& response_sender, tCallStorage* request_storage,
+                           const tWireFormat& wire_format = tWireFormat::Legacy());
 
 
 //----------------------------------------------------------------------
@@ -116,6 +165,9 @@ private:
     internal::tDeserializeMessage deserialize_message;
     internal::tDeserializeRequest deserialize_request;
     internal::tDeserializeResponse deserialize_response;
+
+    /*! function to forward request without deserializing its parameters */
+    internal::tForwardRequest forward_request;
   };
 
   /*!
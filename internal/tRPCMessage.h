@@ -50,6 +50,8 @@
 //----------------------------------------------------------------------
 #include "plugins/rpc_ports/internal/tAbstractCall.h"
 #include "plugins/rpc_ports/internal/tCallStorage.h"
+#include "plugins/rpc_ports/internal/tParameterCache.h"
+#include "plugins/rpc_ports/internal/tValueBlock.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -101,17 +103,17 @@ public:
     FINROC_LOG_PRINT(DEBUG_VERBOSE_1, "Creating Message ", &storage, " ", &storage.call_type);
   }
 
-  template <typename TReturn, typename TInterface>
-  static void DeserializeAndExecuteCallImplementation(rrlib::serialization::tInputStream& stream, tRPCPort& port, uint8_t function_id)
+  template <typename TInterface, typename TFunction>
+  static void DeserializeAndExecuteCallImplementation(rrlib::serialization::tInputStream& stream, tRPCPort& port, uint8_t function_id, const tWireFormat& wire_format)
   {
     try
     {
-      typedef TReturn(TInterface::*tFunctionPointer)(TArgs...);
-      tParameterTuple parameters;
-      stream >> parameters;
-      tFunctionPointer function_pointer = tRPCInterfaceType<TInterface>::template GetFunction<tFunctionPointer>(function_id);
+      tParameterCache<tParameterTuple, TInterface, TFunction> cached_parameters;
+      tParameterTuple& parameters = cached_parameters.Get();
+      tValueBlock<tParameterTuple>::Deserialize(stream, parameters, wire_format);
+      TFunction function_pointer = tRPCInterfaceType<TInterface>::template GetFunction<TFunction>(function_id);
       tClientPort<TInterface> client_port = tClientPort<TInterface>::Wrap(port, true);
-      ExecuteCallImplementation<TInterface, tFunctionPointer>(client_port, function_pointer, parameters, typename rrlib::util::tIntegerSequenceGenerator<sizeof...(TArgs)>::type());
+      ExecuteCallImplementation<TInterface, TFunction>(client_port, function_pointer, parameters, typename rrlib::util::tIntegerSequenceGenerator<sizeof...(TArgs)>::type());
     }
     catch (const std::exception& e)
     {
@@ -137,16 +139,18 @@ private:
   template <typename TInterface, typename TFunction, int ... SEQUENCE>
   static void ExecuteCallImplementation(tClientPort<TInterface>& client_port, TFunction function_pointer, tParameterTuple& parameters, rrlib::util::tIntegerSequence<SEQUENCE...> sequence)
   {
-    client_port.Call(function_pointer, std::move(std::get<SEQUENCE>(parameters))...);
+    // parameters passed by reference are not moved - so that cached parameters keep their capacity
+    client_port.Call(function_pointer, std::forward<TArgs>(std::get<SEQUENCE>(parameters))...);
   }
 
-  virtual void Serialize(rrlib::serialization::tOutputStream& stream) override
+  virtual void Serialize(rrlib::serialization::tOutputStream& stream, tWireFormat& wire_format) override
   {
     // Deserialized by network transport implementation
-    stream << rpc_interface_type << function_index;
+    wire_format.WriteInterfaceType(stream, rpc_interface_type);
+    stream << function_index;
 
     // Deserialized by this class
-    stream << parameters;
+    tValueBlock<tParameterTuple>::Serialize(stream, parameters, wire_format);
   }
 
 };
@@ -33,6 +33,8 @@
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
 #include "core/port/tPortFactory.h"
+#include "rrlib/thread/tLock.h"
+#include <algorithm>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
@@ -64,6 +66,7 @@ namespace internal
 //----------------------------------------------------------------------
 // Const values
 //----------------------------------------------------------------------
+const rrlib::time::tDuration tRPCPort::cDEFAULT_TIMEOUT = std::chrono::seconds(5);
 
 //----------------------------------------------------------------------
 // Implementation
@@ -97,16 +100,221 @@ static core::tAbstractPortCreationInfo ProcessPortCreationInfo(core::tAbstractPo
 }
 
 
-tRPCPort::tRPCPort(core::tAbstractPortCreationInfo creation_info, tRPCInterface* call_handler) :
+/*!
+ * Calls collected in a thread's batch scope
+ * (vectors are retained - so that collecting calls does not allocate memory once they have grown large enough)
+ *
+ * Only the owning thread accesses the collected calls - so collecting them requires no synchronization.
+ * Batches of all threads are registered - so that ports which are deleted can notify them (see PrepareDelete()).
+ */
+class tRPCPort::tBatch
+{
+public:
+
+  /*! Port that a collected call is sent to */
+  struct tTarget
+  {
+    tRPCPort* port;
+
+    /*! Value of deletion_generation when call was collected */
+    uint64_t generation;
+  };
+
+  /*! Number of nested batch scopes */
+  size_t scope_depth;
+
+  /*! Ports that calls are sent to (same index as calls) */
+  std::vector<tTarget> targets;
+
+  /*! Collected calls */
+  std::vector<tCallPointer> calls;
+
+  /*! Incremented whenever a port is deleted while this batch is active */
+  std::atomic<uint64_t> deletion_generation;
+
+  /*!
+   * Mutex for active and deleted_ports.
+   * Also held while batch is sent - so that ports are not deleted while calls are sent to them.
+   */
+  rrlib::thread::tMutex mutex;
+
+  /*! Does owning thread currently have an active batch scope? */
+  bool active;
+
+  /*! Ports deleted while batch was active - with deletion_generation after deletion (calls collected before are dropped) */
+  std::vector<tTarget> deleted_ports;
+
+  tBatch() : scope_depth(0), targets(), calls(), deletion_generation(0), mutex(), active(false), deleted_ports()
+  {
+    rrlib::thread::tLock lock(RegistryMutex());
+    Registry().push_back(this);
+  }
+
+  ~tBatch()
+  {
+    rrlib::thread::tLock lock(RegistryMutex());
+    Registry().erase(std::find(Registry().begin(), Registry().end(), this));
+  }
+
+  /*!
+   * \return Batches of all threads
+   */
+  static std::vector<tBatch*>& Registry()
+  {
+    static std::vector<tBatch*> registry;
+    return registry;
+  }
+
+  /*!
+   * \return Mutex for registry
+   */
+  static rrlib::thread::tMutex& RegistryMutex()
+  {
+    static rrlib::thread::tMutex mutex;
+    return mutex;
+  }
+
+  /*!
+   * Removes calls to deleted ports from batch (must be called with mutex held)
+   *
+   * \param removed_calls Removed calls are moved to this vector
+   */
+  void RemoveCallsToDeletedPorts(std::vector<tCallPointer>& removed_calls)
+  {
+    for (const tTarget & deleted : deleted_ports)
+    {
+      size_t kept = 0;
+      for (size_t i = 0; i < calls.size(); i++)
+      {
+        if (targets[i].port == deleted.port && targets[i].generation < deleted.generation)
+        {
+          removed_calls.emplace_back(std::move(calls[i]));
+        }
+        else
+        {
+          targets[kept] = targets[i];
+          calls[kept] = std::move(calls[i]);
+          kept++;
+        }
+      }
+      targets.resize(kept);
+      calls.resize(kept);
+    }
+    deleted_ports.clear();
+  }
+};
+
+thread_local tRPCPort::tBatch tRPCPort::thread_batch;
+
+thread_local tRPCPort::tBatch* tRPCPort::current_batch = NULL;
+
+tRPCPort::tBatchScope::tBatchScope()
+{
+  if (thread_batch.scope_depth == 0)
+  {
+    rrlib::thread::tLock lock(thread_batch.mutex);
+    thread_batch.active = true;
+  }
+  current_batch = &thread_batch;
+  current_batch->scope_depth++;
+  tCallStorage::flush_collected_calls_hook = &FlushBatch;
+}
+
+tRPCPort::tBatchScope::~tBatchScope()
+{
+  if (thread_batch.scope_depth == 1)
+  {
+    do
+    {
+      FlushBatch();
+    }
+    while (!thread_batch.calls.empty()); // calls might have been collected in nested batch scope while sending
+    current_batch = NULL;
+    tCallStorage::flush_collected_calls_hook = NULL;
+    rrlib::thread::tLock lock(thread_batch.mutex);
+    thread_batch.active = false;
+    thread_batch.deleted_ports.clear();
+  }
+  thread_batch.scope_depth--;
+}
+
+tRPCPort::tRPCPort(core::tAbstractPortCreationInfo creation_info, tRPCInterface* call_handler, tExecutor* executor, tServerSynchronization synchronization) :
   core::tAbstractPort(ProcessPortCreationInfo(creation_info)),
-  call_handler(call_handler)
+  call_handler(call_handler),
+  executor(executor),
+  server_lock(synchronization == tServerSynchronization::READER_WRITER ? new tReaderWriterLock() : NULL),
+  server_guard(executor ? new tServerGuard() : NULL),
+  wait_policy(),
+  default_timeout(rrlib::time::tDuration::zero()),
+  connection_epoch(1)
 {}
 
 tRPCPort::~tRPCPort()
-{}
+{
+  if (server_guard)
+  {
+    server_guard->Invalidate(); // in case port is deleted without PrepareDelete()
+  }
+}
+
+void tRPCPort::FlushBatch()
+{
+  if (!current_batch)
+  {
+    return; // no active batch scope - or batch is currently being flushed
+  }
+
+  // Calls are moved out of batch and current_batch is unset while sending
+  // (so that calls sent by SendCall() implementations are not added to the vectors being iterated - but are sent directly)
+  tBatch& batch = *current_batch;
+  current_batch = NULL;
+  std::vector<tBatch::tTarget> targets;
+  std::vector<tCallPointer> calls;
+  std::vector<tCallPointer> removed_calls;
+  {
+    rrlib::thread::tLock lock(batch.mutex);
+    batch.RemoveCallsToDeletedPorts(removed_calls);
+    targets.swap(batch.targets);
+    calls.swap(batch.calls);
+
+    size_t run_start = 0;
+    for (size_t i = 1; i <= calls.size(); i++)
+    {
+      // Consecutive calls to the same port are sent in one operation
+      if (i == calls.size() || targets[i].port != targets[run_start].port)
+      {
+        try
+        {
+          targets[run_start].port->SendCalls(&calls[run_start], i - run_start);
+        }
+        catch (const std::exception& e)
+        {
+          FINROC_LOG_PRINT_STATIC(ERROR, "Sending batch of calls failed: ", e);
+        }
+        run_start = i;
+      }
+    }
+  }
+  for (tCallPointer & call : removed_calls)
+  {
+    if (call->GetFutureStatus() == tFutureStatus::PENDING)
+    {
+      call->SetException(tFutureStatus::NO_CONNECTION);
+    }
+  }
 
+  // Retain vectors' memory for next batch (unless calls were collected in a nested batch scope while sending)
+  if (batch.calls.empty())
+  {
+    targets.clear();
+    calls.clear();
+    targets.swap(batch.targets);
+    calls.swap(batch.calls);
+  }
+  current_batch = &batch;
+}
 
-tRPCPort* tRPCPort::GetServer(bool include_network_ports) const
+tRPCPort* tRPCPort::FindServer(bool include_network_ports) const
 {
   tRPCPort* current = const_cast<tRPCPort*>(this);
   while (true)
@@ -152,11 +360,21 @@ core::tAbstractPort::tConnectDirection tRPCPort::InferConnectDirection(const tAb
   return tAbstractPort::InferConnectDirection(other);
 }
 
+void tRPCPort::InvalidateServerCaches()
+{
+  connection_epoch++;
+  for (auto it = this->IncomingConnectionsBegin(); it != this->IncomingConnectionsEnd(); ++it)
+  {
+    static_cast<tRPCPort&>(*it).InvalidateServerCaches();
+  }
+}
+
 void tRPCPort::OnConnect(tAbstractPort& partner, bool partner_is_destination)
 {
   // Disconnect any server ports we might already be connected to.
   if (partner_is_destination)
   {
+    InvalidateServerCaches();
     for (auto it = this->OutgoingConnectionsBegin(); it != this->OutgoingConnectionsEnd(); ++it)
     {
       if (&(*it) != &partner)
@@ -168,6 +386,63 @@ void tRPCPort::OnConnect(tAbstractPort& partner, bool partner_is_destination)
   }
 }
 
+void tRPCPort::OnDisconnect(tAbstractPort&, bool partner_is_destination)
+{
+  if (partner_is_destination)
+  {
+    InvalidateServerCaches();
+  }
+}
+
+void tRPCPort::PrepareDelete()
+{
+  // Calls that threads have collected for this port cannot be sent anymore.
+  // Locking the batches also waits for batches that are currently being sent.
+  {
+    rrlib::thread::tLock lock(tBatch::RegistryMutex());
+    for (tBatch * batch : tBatch::Registry())
+    {
+      rrlib::thread::tLock batch_lock(batch->mutex);
+      if (batch->active)
+      {
+        batch->deleted_ports.push_back(tBatch::tTarget { this, batch->deletion_generation.fetch_add(1) + 1 });
+      }
+    }
+  }
+
+  // Calls still queued in executor must not access server anymore (they fail with NO_CONNECTION)
+  if (server_guard)
+  {
+    server_guard->Invalidate();
+  }
+  core::tAbstractPort::PrepareDelete();
+}
+
+void tRPCPort::SendOrCollectCall(tCallPointer && call_to_send)
+{
+  if (current_batch)
+  {
+    current_batch->targets.push_back(tBatch::tTarget { this, current_batch->deletion_generation.load(std::memory_order_relaxed) });
+    current_batch->calls.emplace_back(std::move(call_to_send));
+    return;
+  }
+  SendCall(std::move(call_to_send));
+}
+
+tRPCPort* tRPCPort::UpdateServerCache(bool include_network_ports) const
+{
+  // Connections are changed while holding structure mutex. Holding it here ensures that the
+  // epoch we obtain belongs to the connections we traverse - even if epoch is incremented before connections are changed.
+  rrlib::thread::tLock lock(GetStructureMutex());
+  tServerCache& cache = server_cache[include_network_ports ? 1 : 0];
+  uint64_t epoch = connection_epoch.load();
+  tRPCPort* server = FindServer(include_network_ports);
+  cache.epoch.store(0);
+  cache.server.store(server);
+  cache.epoch.store(epoch);
+  return server;
+}
+
 //----------------------------------------------------------------------
 // End of namespace declaration
 //----------------------------------------------------------------------
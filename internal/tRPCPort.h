@@ -46,6 +46,8 @@
 //----------------------------------------------------------------------
 #include "plugins/rpc_ports/tRPCInterface.h"
 #include "plugins/rpc_ports/internal/tCallStorage.h"
+#include "plugins/rpc_ports/internal/tReaderWriterLock.h"
+#include "plugins/rpc_ports/internal/tServerGuard.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -54,12 +56,14 @@ namespace finroc
 {
 namespace rpc_ports
 {
-namespace internal
-{
 
 //----------------------------------------------------------------------
 // Forward declarations / typedefs / enums
 //----------------------------------------------------------------------
+class tExecutor;
+
+namespace internal
+{
 
 //----------------------------------------------------------------------
 // Class declaration
@@ -102,11 +106,48 @@ public:
   /*! Stores calls internally */
   typedef std::unique_ptr<tCallStorage, tCallDeleter> tCallPointer;
 
+  /*! Timeout for calls if neither client port nor called function specify a default timeout */
+  static const rrlib::time::tDuration cDEFAULT_TIMEOUT;
+
+  /*!
+   * While an object of this class exists, calls that the current thread sends to network ports
+   * are collected - and handed to the network ports in batches when the (outermost) scope ends
+   * (so that transports can serialize and flush them as one frame).
+   * Collected calls are also sent before the current thread waits for the result of a call.
+   * Scopes may be nested.
+   */
+  class tBatchScope : private rrlib::util::tNoncopyable
+  {
+  public:
+    tBatchScope();
+    ~tBatchScope();
+  };
 
-  tRPCPort(core::tAbstractPortCreationInfo creation_info, tRPCInterface* call_handler);
+
+  /*!
+   * \param creation_info Port creation info
+   * \param call_handler Pointer to object that handles calls on server side (NULL for client, proxy and network ports)
+   * \param executor Executor that executes calls to this server port (NULL: calls are executed by the threads that invoke them)
+   * \param synchronization How calls to server functions are synchronized (server ports only)
+   */
+  tRPCPort(core::tAbstractPortCreationInfo creation_info, tRPCInterface* call_handler, tExecutor* executor = NULL,
+           tServerSynchronization synchronization = tServerSynchronization::NONE);
 
   ~tRPCPort();
 
+  /*!
+   * Called on network ports before calls are forwarded to them with their serialized parameters
+   * (see tRPCInterfaceTypeInfo::GetForwardingTarget()).
+   * To be overridden by network port subclasses that support forwarding (by default, calls are not forwarded).
+   *
+   * \param source_wire_format Wire format of the connection the parameters were received from
+   * \return True if the parameters can be written unchanged to this port's connection (see tWireFormat::HasCompatibleParameterEncoding())
+   */
+  virtual bool AcceptsForwardedParameters(const tWireFormat& source_wire_format) const
+  {
+    return false;
+  }
+
 
 //  /*!
 //   * Deserializes call from stream and executes it
@@ -129,13 +170,68 @@ public:
     return call_handler;
   }
 
+  /*!
+   * \return Executor that executes calls to this server port (NULL if calls are executed by the threads that invoke them)
+   */
+  tExecutor* GetExecutor() const
+  {
+    return executor;
+  }
+
+  /*!
+   * \return Guard for calls to this server port that are queued in its executor (NULL if port has no executor)
+   */
+  const std::shared_ptr<tServerGuard>& GetServerGuard() const
+  {
+    return server_guard;
+  }
+
+  /*!
+   * \return Lock that is held while server functions are called (NULL if framework does not synchronize calls to this server)
+   */
+  tReaderWriterLock* GetServerLock() const
+  {
+    return server_lock.get();
+  }
+
   /*!
    * (Usually called on client ports)
    *
+   * Server is cached - so that connection chain is only traversed again after connections changed.
+   *
    * \param include_network_ports Also return network ports?
    * \return "Server" Port that handles method call (or null if there is no such port)
    */
-  tRPCPort* GetServer(bool include_network_ports = false) const;
+  tRPCPort* GetServer(bool include_network_ports = false) const
+  {
+    tServerCache& cache = server_cache[include_network_ports ? 1 : 0];
+    uint64_t cache_epoch = cache.epoch.load();
+    if (cache_epoch == connection_epoch.load())
+    {
+      tRPCPort* server = cache.server.load();
+      if (cache.epoch.load() == cache_epoch) // cache was not updated concurrently
+      {
+        return server;
+      }
+    }
+    return UpdateServerCache(include_network_ports);
+  }
+
+  /*!
+   * \return Default timeout for calls from this port (zero if none is set - function defaults or cDEFAULT_TIMEOUT apply then)
+   */
+  rrlib::time::tDuration GetDefaultTimeout() const
+  {
+    return default_timeout;
+  }
+
+  /*!
+   * \return Policy for waiting for results of synchronous calls from this port
+   */
+  const tWaitPolicy& GetWaitPolicy() const
+  {
+    return wait_policy;
+  }
 
   /*!
    * \return Is this a server rpc port?
@@ -145,23 +241,58 @@ public:
     return GetFlag(tFlag::ACCEPTS_DATA) && (!GetFlag(tFlag::EMITS_DATA));
   }
 
+  /*!
+   * \param default_timeout Default timeout for calls from this port (zero to unset)
+   * (should be set before port is used for calls)
+   */
+  void SetDefaultTimeout(const rrlib::time::tDuration& default_timeout)
+  {
+    this->default_timeout = default_timeout;
+  }
+
+  /*!
+   * \param wait_policy Policy for waiting for results of synchronous calls from this port
+   * (should be set before port is used for calls)
+   */
+  void SetWaitPolicy(const tWaitPolicy& wait_policy)
+  {
+    this->wait_policy = wait_policy;
+  }
+
   /*!
    * Sends call to somewhere else
    * (Meant to be called on network ports that forward calls to other runtime environments)
+   * If the current thread has an active batch scope, call is sent when scope ends.
    *
    * \param call_to_send Call that is sent
    */
   void SendCall(typename tCallStorage::tPointer& call_to_send)
   {
     assert(IsFuturePointer(*call_to_send) == false);
-    SendCall(tCallPointer(call_to_send.release()));
+    if (call_to_send->GetCallType() == tCallType::RPC_REQUEST)
+    {
+      tTimerWheel::Add(*call_to_send); // completes call with TIMEOUT if no response arrives before its deadline
+    }
+    SendOrCollectCall(tCallPointer(call_to_send.release()));
   }
   void SendCall(typename tCallStorage::tFuturePointer && call_to_send)
   {
     assert(IsFuturePointer(*call_to_send) == true);
-    SendCall(tCallPointer(call_to_send.release()));
+    SendOrCollectCall(tCallPointer(call_to_send.release()));
   }
 
+//----------------------------------------------------------------------
+// Protected methods
+//----------------------------------------------------------------------
+protected:
+
+  /*!
+   * Removes calls to this port from batches of all threads (see tBatchScope).
+   * Waits for batches that are currently being sent.
+   * Network port subclasses overriding this method must call it.
+   */
+  virtual void PrepareDelete() override;
+
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
@@ -169,12 +300,81 @@ private:
 
   friend class tResponseSender;
 
+  /*! Calls collected in a thread's batch scope (defined in tRPCPort.cpp) */
+  class tBatch;
+
+  /*!
+   * Cached server port.
+   * Valid as long as epoch equals connection_epoch.
+   * Updated while holding structure mutex (readers only need to check epoch before and after reading server).
+   */
+  struct tServerCache
+  {
+    /*! Value of connection_epoch when server was determined (0 while invalid or updating) */
+    std::atomic<uint64_t> epoch;
+
+    /*! Cached server port */
+    std::atomic<tRPCPort*> server;
+
+    tServerCache() : epoch(0), server(NULL) {}
+  };
+
+  /*! Batch object of current thread */
+  static thread_local tBatch thread_batch;
+
+  /*! Batch of current thread (NULL if thread has no active batch scope) */
+  static thread_local tBatch* current_batch;
+
   /*! Pointer to object that handles calls on server side */
   tRPCInterface* const call_handler;
 
+  /*! Executor that executes calls to this server port (NULL if calls are executed by the threads that invoke them) */
+  tExecutor* const executor;
+
+  /*! Lock that is held while server functions are called (NULL if framework does not synchronize calls to this server) */
+  std::unique_ptr<tReaderWriterLock> server_lock;
+
+  /*! Guard for calls to this server port that are queued in its executor (NULL if port has no executor) */
+  std::shared_ptr<tServerGuard> server_guard;
+
+  /*! Policy for waiting for results of synchronous calls from this port */
+  tWaitPolicy wait_policy;
+
+  /*! Default timeout for calls from this port (zero if none is set) */
+  rrlib::time::tDuration default_timeout;
+
+  /*!
+   * Incremented whenever outgoing connections of this port - or of a port that calls are forwarded to - change.
+   * Invalidates this port's server caches only.
+   */
+  std::atomic<uint64_t> connection_epoch;
+
+  /*! Cached servers (index 0: without network ports; index 1: including network ports) */
+  mutable tServerCache server_cache[2];
+
 
   virtual tAbstractPort::tConnectDirection InferConnectDirection(const tAbstractPort& other) const override;
 
+  /*!
+   * Traverses connections to server port
+   *
+   * \param include_network_ports Also return network ports?
+   * \return "Server" Port that handles method call (or null if there is no such port)
+   */
+  tRPCPort* FindServer(bool include_network_ports) const;
+
+  /*!
+   * Invalidates server caches of this port and of all ports whose calls are forwarded via this port
+   * (called with structure mutex held whenever outgoing connections of this port change)
+   */
+  void InvalidateServerCaches();
+
+  /*!
+   * Sends all calls in current thread's batch
+   * (does nothing if thread has no active batch scope - or if batch is currently being sent)
+   */
+  static void FlushBatch();
+
   static bool IsFuturePointer(tCallStorage& call_storage)
   {
     return call_storage.call_ready_for_sending == &(call_storage.future_status); // slightly ugly... but memory efficient (and we have the assertions)
@@ -182,6 +382,8 @@ private:
 
   virtual void OnConnect(tAbstractPort& partner, bool partner_is_destination) override;
 
+  virtual void OnDisconnect(tAbstractPort& partner, bool partner_is_destination) override;
+
   /*!
    * To be overridden by network port subclass
    */
@@ -189,6 +391,37 @@ private:
   {
     throw std::runtime_error("Not a network port");
   }
+
+  /*!
+   * May be overridden by network port subclass to send multiple calls in one operation
+   * (e.g. to serialize and flush them as one frame). Default implementation calls SendCall() for each call.
+   * Called while the sending thread's batch is locked: implementations must not delete ports or wait for the runtime's structure mutex.
+   *
+   * \param calls_to_send Calls that are sent (in this order)
+   * \param count Number of calls
+   */
+  virtual void SendCalls(tCallPointer* calls_to_send, size_t count)
+  {
+    for (size_t i = 0; i < count; i++)
+    {
+      SendCall(std::move(calls_to_send[i]));
+    }
+  }
+
+  /*!
+   * Sends call - or adds it to current thread's batch if thread has an active batch scope
+   *
+   * \param call_to_send Call that is sent
+   */
+  void SendOrCollectCall(tCallPointer && call_to_send);
+
+  /*!
+   * Determines server and stores it in cache
+   *
+   * \param include_network_ports Also return network ports?
+   * \return "Server" Port that handles method call (or null if there is no such port)
+   */
+  tRPCPort* UpdateServerCache(bool include_network_ports) const;
 };
 
 //----------------------------------------------------------------------
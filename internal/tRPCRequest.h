@@ -50,6 +50,8 @@
 #include "plugins/rpc_ports/internal/tAbstractCall.h"
 #include "plugins/rpc_ports/internal/tRPCPort.h"
 #include "plugins/rpc_ports/internal/tRPCResponse.h"
+#include "plugins/rpc_ports/internal/tParameterCache.h"
+#include "plugins/rpc_ports/internal/tValueBlock.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -67,6 +69,9 @@ class tRPCInterfaceType;
 
 namespace internal
 {
+template <typename TReturn, typename ... TArgs>
+class tForwardedRequest;
+
 //----------------------------------------------------------------------
 // Class declaration
 //----------------------------------------------------------------------
@@ -103,26 +108,24 @@ public:
     future_obtained(false)
   {
     storage.local_port_handle = local_rpc_port.GetHandle();
-    storage.response_timeout = timeout;
+    storage.SetResponseTimeout(timeout);
     storage.call_type = tCallType::RPC_REQUEST;
     FINROC_LOG_PRINT(DEBUG_VERBOSE_1, "Creating Request ", &storage, " ", &storage.call_type);
   }
 
-  template <typename TInterface>
-  static void DeserializeAndExecuteCallImplementation(rrlib::serialization::tInputStream& stream, tRPCPort& port, uint8_t function_id, tResponseSender& response_sender)
+  template <typename TInterface, typename TFunction>
+  static void DeserializeAndExecuteCallImplementation(rrlib::serialization::tInputStream& stream, tRPCPort& port, uint8_t function_id, tResponseSender& response_sender, const tWireFormat& wire_format)
   {
     try
     {
-      typedef TReturn(TInterface::*tFunctionPointer)(TArgs...);
-      tCallId remote_call_id;
-      stream >> remote_call_id;
-      rrlib::time::tDuration timeout;
-      stream >> timeout;
-      tParameterTuple parameters;
-      stream >> parameters;
-      tFunctionPointer function_pointer = tRPCInterfaceType<TInterface>::template GetFunction<tFunctionPointer>(function_id);
+      tCallId remote_call_id = wire_format.ReadCallId(stream);
+      rrlib::time::tDuration timeout = wire_format.ReadTimeout(stream); // remaining time until deadline of caller
+      tParameterCache<tParameterTuple, TInterface, TFunction> cached_parameters;
+      tParameterTuple& parameters = cached_parameters.Get();
+      tValueBlock<tParameterTuple>::Deserialize(stream, parameters, wire_format);
+      TFunction function_pointer = tRPCInterfaceType<TInterface>::template GetFunction<TFunction>(function_id);
       tClientPort<TInterface> client_port = tClientPort<TInterface>::Wrap(port, true);
-      ExecuteCallImplementation<cNATIVE_FUTURE_FUNCTION, TInterface, tFunctionPointer>(client_port, response_sender, function_pointer, timeout, parameters, function_id, remote_call_id, typename rrlib::util::tIntegerSequenceGenerator<sizeof...(TArgs)>::type());
+      ExecuteCallImplementation<cNATIVE_FUTURE_FUNCTION, TInterface, TFunction>(client_port, response_sender, function_pointer, timeout, parameters, function_id, remote_call_id, typename rrlib::util::tIntegerSequenceGenerator<sizeof...(TArgs)>::type());
     }
     catch (const std::exception& e)
     {
@@ -161,21 +164,25 @@ public:
    */
   void ReturnValue(tReturnInternal && return_value)
   {
-    tFutureStatus current = (tFutureStatus)storage.future_status.load();
+    tFutureStatus current = storage.GetFutureStatus();
     if (current != tFutureStatus::PENDING)
     {
-      FINROC_LOG_PRINT(WARNING, "Call already has status ", make_builder::GetEnumString(current), ". Ignoring.");
+      if (current == tFutureStatus::TIMEOUT)
+      {
+        FINROC_LOG_PRINT(DEBUG, "Response arrived after call timed out. Ignoring.");
+      }
+      else
+      {
+        FINROC_LOG_PRINT(WARNING, "Call already has status ", make_builder::GetEnumString(current), ". Ignoring.");
+      }
       return;
     }
 
-    rrlib::thread::tLock lock(storage.mutex);
     result_buffer = std::move(return_value);
-    storage.future_status.store((int)tFutureStatus::READY);
-    storage.condition_variable.notify_one();
-    if (storage.response_handler)
+    tAbstractResponseHandler* handler = storage.Complete(tFutureStatus::READY);
+    if (handler)
     {
-      lock.Unlock();
-      static_cast<tResponseHandler<tReturnInternal>*>(storage.response_handler)->HandleResponse(std::move(return_value));
+      static_cast<tResponseHandler<tReturnInternal>*>(handler)->HandleResponse(std::move(result_buffer));
     }
   }
 
@@ -189,7 +196,7 @@ public:
 
   void SetResponseHandler(tResponseHandler<TReturn>& response_handler)
   {
-    storage.response_handler = &response_handler;
+    storage.response_handler.store(&response_handler);
   }
 
 //----------------------------------------------------------------------
@@ -197,6 +204,8 @@ public:
 //----------------------------------------------------------------------
 private:
 
+  friend class tForwardedRequest<TReturn, TArgs...>;
+
   /*! RPC Interface Type */
   rrlib::rtti::tType rpc_interface_type;
 
@@ -220,19 +229,24 @@ private:
   static void ExecuteCallImplementation(typename std::enable_if < !NATIVE_FUTURE_CALL, tClientPort<TInterface >>::type& client_port, tResponseSender& response_sender, TFunction function_pointer,
                                         const rrlib::time::tDuration& timeout, tParameterTuple& parameters, uint8_t function_id, tCallId call_id, rrlib::util::tIntegerSequence<SEQUENCE...> sequence)
   {
-    typename tCallStorage::tPointer call_storage = tCallStorage::GetUnused();
-    tRPCResponse<TReturn>& response = call_storage->Emplace<tRPCResponse<TReturn>>(*call_storage, client_port.GetDataType(), function_id);
+    // Network thread must not block (e.g. if call is forwarded to another remote server):
+    // Response is handed to response sender immediately - and is sent as soon as future is ready (see tRPCResponse<tFuture<T>>)
+    typedef tRPCResponse<tFuture<TReturn>> tResponse;
+    typename tCallStorage::tPointer call_storage = tCallStorage::GetUnused<tResponse>();
+    tResponse& response = call_storage->Emplace<tResponse>(*call_storage, client_port.GetDataType(), function_id, timeout);
     response.SetCallId(call_id);
-    try
+    if (timeout <= rrlib::time::tDuration::zero())
     {
-      response.SetReturnValue(client_port.template CallSynchronous<TFunction, typename std::decay<TArgs>::type ...>
-                              (timeout, function_pointer, std::move(std::get<SEQUENCE>(parameters))...));
-      call_storage->local_port_handle = client_port.GetWrapped()->GetHandle();
+      // Deadline has passed already: nobody is waiting for the result anymore
+      response.SetReturnValue(tFuture<TReturn>(tFutureStatus::TIMEOUT));
     }
-    catch (const tRPCException& e)
+    else
     {
-      call_storage->SetException(e.GetType());
+      // parameters passed by reference are not moved - so that cached parameters keep their capacity
+      response.SetReturnValue(client_port.template FutureCall<TFunction, TArgs...>
+                              (timeout, function_pointer, std::forward<TArgs>(std::get<SEQUENCE>(parameters))...));
     }
+    call_storage->local_port_handle = client_port.GetWrapped()->GetHandle();
     response_sender.SendResponse(call_storage);
   }
 
@@ -240,13 +254,20 @@ private:
   static void ExecuteCallImplementation(typename std::enable_if<NATIVE_FUTURE_CALL, tClientPort<TInterface>>::type& client_port, tResponseSender& response_sender, TFunction function_pointer,
                                         const rrlib::time::tDuration& timeout, tParameterTuple& parameters, uint8_t function_id, tCallId call_id, rrlib::util::tIntegerSequence<SEQUENCE...> sequence)
   {
-    typename tCallStorage::tPointer call_storage = tCallStorage::GetUnused();
-    tRPCResponse<TReturn>& response = call_storage->Emplace<tRPCResponse<TReturn>>(*call_storage, client_port.GetDataType(), function_id);
+    typename tCallStorage::tPointer call_storage = tCallStorage::GetUnused<tRPCResponse<TReturn>>();
+    tRPCResponse<TReturn>& response = call_storage->Emplace<tRPCResponse<TReturn>>(*call_storage, client_port.GetDataType(), function_id, timeout);
     response.SetCallId(call_id);
+    if (timeout <= rrlib::time::tDuration::zero())
+    {
+      // Deadline has passed already: nobody is waiting for the result anymore
+      call_storage->SetException(tFutureStatus::TIMEOUT);
+      response_sender.SendResponse(call_storage);
+      return;
+    }
     try
     {
-      response.SetReturnValue(client_port.template NativeFutureCall<TFunction, typename std::decay<TArgs>::type ...>
-                              (function_pointer, std::move(std::get<SEQUENCE>(parameters))...));
+      response.SetReturnValue(client_port.template NativeFutureCall<TFunction, TArgs...>
+                              (timeout, function_pointer, std::forward<TArgs>(std::get<SEQUENCE>(parameters))...));
       call_storage->local_port_handle = client_port.GetWrapped()->GetHandle();
     }
     catch (const tRPCException& e)
@@ -256,30 +277,31 @@ private:
     response_sender.SendResponse(call_storage);
   }
 
-  virtual void ReturnValue(rrlib::serialization::tInputStream& stream, tResponseSender& response_sender) override
+  virtual void ReturnValue(rrlib::serialization::tInputStream& stream, tResponseSender& response_sender, const tWireFormat& wire_format) override
   {
     tReturnInternal result;
-    tReturnSerialization::Deserialize(stream, result, response_sender, function_index, rpc_interface_type);
+    tReturnSerialization::Deserialize(stream, result, response_sender, function_index, rpc_interface_type, wire_format);
     ReturnValue(std::move(result));
   }
 
-  virtual void Serialize(rrlib::serialization::tOutputStream& stream) override
+  virtual void Serialize(rrlib::serialization::tOutputStream& stream, tWireFormat& wire_format) override
   {
     // Deserialized by network transport implementation
-    stream << rpc_interface_type << function_index;
+    wire_format.WriteInterfaceType(stream, rpc_interface_type);
+    stream << function_index;
 
     // Deserialized by this class
-    stream << storage.call_id;
-    stream << storage.response_timeout;
-    stream << parameters;
+    wire_format.WriteCallId(stream, storage.call_id);
+    wire_format.WriteTimeout(stream, storage.RemainingTime()); // deadline is transferred as remaining time (monotonic clocks of different processes are not comparable)
+    tValueBlock<tParameterTuple>::Serialize(stream, parameters, wire_format);
   }
 
 };
 
 struct tNoRPCRequest
 {
-  template <typename TInterface>
-  static void DeserializeAndExecuteCallImplementation(rrlib::serialization::tInputStream& stream, tRPCPort& port, uint8_t function_id, tResponseSender& response_sender)
+  template <typename TInterface, typename TFunction>
+  static void DeserializeAndExecuteCallImplementation(rrlib::serialization::tInputStream& stream, tRPCPort& port, uint8_t function_id, tResponseSender& response_sender, const tWireFormat& wire_format)
   {
     throw new std::runtime_error("Not supported for functions returning void");
   }
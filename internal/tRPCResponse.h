@@ -87,7 +87,14 @@ class tRPCResponse : public tAbstractCall //, public tResponseHandler<TReturn>
 //----------------------------------------------------------------------
 public:
 
-  tRPCResponse(tCallStorage& storage, const rrlib::rtti::tType& rpc_interface_type, uint8_t function_index) :
+  /*!
+   * \param storage Storage this response is allocated in
+   * \param rpc_interface_type RPC interface type
+   * \param function_index Index of function in interface
+   * \param request_timeout Remaining time until deadline of request this is the response to
+   *                        (for promise responses: time the response waits for a promise value from the other side)
+   */
+  tRPCResponse(tCallStorage& storage, const rrlib::rtti::tType& rpc_interface_type, uint8_t function_index, const rrlib::time::tDuration& request_timeout = tRPCPort::cDEFAULT_TIMEOUT) :
     rpc_interface_type(rpc_interface_type),
     function_index(function_index),
     result_buffer(),
@@ -95,28 +102,34 @@ public:
     future_obtained(false),
     call_id(std::numeric_limits<tCallId>::max())
   {
-    storage.response_timeout = cPROMISE_RESULT ? std::chrono::hours(24) : std::chrono::seconds(0); // TODO: put something sensible here
+    if (cPROMISE_RESULT)
+    {
+      storage.SetResponseTimeout(request_timeout);
+    }
+    else
+    {
+      storage.response_timeout = rrlib::time::tDuration::zero();
+    }
     storage.call_type = tCallType::RPC_RESPONSE;
     FINROC_LOG_PRINT(DEBUG_VERBOSE_1, "Creating Response ", &storage, " ", &storage.call_type);
   }
 
 
-  // TODO: Ensure that tCallStorage* request is not recycled while we're calling this. tFuturePointer or lock?
+  // Caller must hold a reference to request while calling this (e.g. the pointer obtained from tPendingCallTable::Take())
   static void DeserializeAndExecuteCallImplementation(rrlib::serialization::tInputStream& stream, const rrlib::rtti::tType& rpc_interface_type,
-      uint8_t function_id, tResponseSender& response_sender, tCallStorage* request)
+      uint8_t function_id, tResponseSender& response_sender, tCallStorage* request, const tWireFormat& wire_format)
   {
     try
     {
       bool promise_response;
-      stream >> promise_response;
       tFutureStatus status;
-      stream >> status;
+      wire_format.ReadResponseStatus(stream, promise_response, status);
       FINROC_LOG_PRINT_STATIC(DEBUG_VERBOSE_1, promise_response, " ", make_builder::GetEnumString(status));
       if (status == tFutureStatus::READY)
       {
         if (request && request->GetCall())
         {
-          request->GetCall()->ReturnValue(stream, response_sender);
+          request->GetCall()->ReturnValue(stream, response_sender, wire_format);
         }
         else
         {
@@ -124,7 +137,7 @@ public:
           {
             // make sure e.g. promises are broken
             TReturn returned;
-            tReturnSerialization::Deserialize(stream, returned, response_sender, function_id, rpc_interface_type);
+            tReturnSerialization::Deserialize(stream, returned, response_sender, function_id, rpc_interface_type, wire_format);
           }
           else
           {
@@ -219,7 +232,7 @@ private:
   tCallId call_id;
 
 
-  virtual void ReturnValue(rrlib::serialization::tInputStream& stream, tResponseSender& response_sender) override
+  virtual void ReturnValue(rrlib::serialization::tInputStream& stream, tResponseSender& response_sender, const tWireFormat& wire_format) override
   {
     ReturnValueImplementation(stream);
   }
@@ -238,19 +251,19 @@ private:
     throw std::runtime_error("Not a promise response");
   }
 
-  virtual void Serialize(rrlib::serialization::tOutputStream& stream) override
+  virtual void Serialize(rrlib::serialization::tOutputStream& stream, tWireFormat& wire_format) override
   {
     // Deserialized by network transport implementation
-    stream << rpc_interface_type << function_index;
-    stream << call_id;
+    wire_format.WriteInterfaceType(stream, rpc_interface_type);
+    stream << function_index;
+    wire_format.WriteCallId(stream, call_id);
 
     // Deserialized by this class
-    stream << false; // promise_response
-    tFutureStatus status = (tFutureStatus)storage.future_status.load();
-    stream << status;
+    tFutureStatus status = storage.GetFutureStatus();
+    wire_format.WriteResponseStatus(stream, false, status);
     if (status == tFutureStatus::READY)
     {
-      tReturnSerialization::Serialize(stream, result_buffer, storage);
+      tReturnSerialization::Serialize(stream, result_buffer, storage, wire_format);
     }
   }
 };
@@ -266,8 +279,8 @@ class tRPCResponse<tFuture<TReturn>> : public tRPCResponse<TReturn>
 //----------------------------------------------------------------------
 public:
 
-  tRPCResponse(tCallStorage& storage, const rrlib::rtti::tType& rpc_interface_type, uint8_t function_index) :
-    tBase(storage, rpc_interface_type, function_index),
+  tRPCResponse(tCallStorage& storage, const rrlib::rtti::tType& rpc_interface_type, uint8_t function_index, const rrlib::time::tDuration& request_timeout = tRPCPort::cDEFAULT_TIMEOUT) :
+    tBase(storage, rpc_interface_type, function_index, request_timeout),
     response_future()
   {
   }
@@ -281,7 +294,7 @@ public:
    */
   void SetReturnValue(tFuture<TReturn> && return_value)
   {
-    this->storage.call_ready_for_sending = &return_value.storage->future_status;
+    this->storage.call_ready_for_sending = return_value.storage ? &return_value.storage->future_status : NULL; // futures without storage are ready
     response_future = std::move(return_value);
     this->storage.future_status.store((int)tFutureStatus::READY);
   }
@@ -295,27 +308,27 @@ private:
   tFuture<TReturn> response_future;
 
 
-  virtual void Serialize(rrlib::serialization::tOutputStream& stream) override
+  virtual void Serialize(rrlib::serialization::tOutputStream& stream, tWireFormat& wire_format) override
   {
     // Deserialized by network transport implementation
-    stream << this->rpc_interface_type << this->function_index;
-    stream << this->call_id;
+    wire_format.WriteInterfaceType(stream, this->rpc_interface_type);
+    stream << this->function_index;
+    wire_format.WriteCallId(stream, this->call_id);
 
     // Deserialized by this class
-    stream << false; // promise_response
-    tFutureStatus status = (tFutureStatus)this->storage.future_status.load();
+    tFutureStatus status = this->storage.GetFutureStatus();
     FINROC_LOG_PRINT(DEBUG_VERBOSE_1, make_builder::GetEnumString(status));
     if (status == tFutureStatus::READY)
     {
-      status = (tFutureStatus)this->storage.call_ready_for_sending->load();
+      status = response_future.GetStatus();
     }
     FINROC_LOG_PRINT(DEBUG_VERBOSE_1, make_builder::GetEnumString(status));
-    stream << status;
+    wire_format.WriteResponseStatus(stream, false, status);
     if (status == tFutureStatus::READY)
     {
       assert(response_future.Ready() && "only ready responses should be serialized");
       this->result_buffer = response_future.Get();
-      tBase::tReturnSerialization::Serialize(stream, this->result_buffer, this->storage);
+      tBase::tReturnSerialization::Serialize(stream, this->result_buffer, this->storage, wire_format);
     }
   }
 };
@@ -323,7 +336,7 @@ private:
 struct tNoRPCResponse
 {
   static void DeserializeAndExecuteCallImplementation(rrlib::serialization::tInputStream& stream, const rrlib::rtti::tType&,
-      uint8_t function_id, tResponseSender& response_sender, tCallStorage* request)
+      uint8_t function_id, tResponseSender& response_sender, tCallStorage* request, const tWireFormat& wire_format)
   {
     throw new std::runtime_error("Not supported for functions returning void");
   }
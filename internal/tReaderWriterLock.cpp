@@ -0,0 +1,188 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/internal/tReaderWriterLock.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/internal/tReaderWriterLock.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <sched.h>
+#include <climits>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/tRPCException.h"
+#include "plugins/rpc_ports/internal/tFutex.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+/*! Maximum time a reader blocks before checking lock again */
+static const rrlib::time::tDuration cMAX_READER_WAIT = std::chrono::milliseconds(100);
+
+/*! Maximum time a writer blocks before checking reader counters again */
+static const rrlib::time::tDuration cMAX_WRITER_WAIT = std::chrono::milliseconds(100);
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+thread_local tReaderWriterLock::tScopedLock* tReaderWriterLock::tScopedLock::innermost_lock = NULL;
+
+tReaderWriterLock::tReaderWriterLock() :
+  reader_counters(),
+  writer_active(0),
+  readers_left(0),
+  writer_mutex()
+{
+  for (tReaderCounter & counter : reader_counters)
+  {
+    counter.count.store(0);
+  }
+}
+
+size_t tReaderWriterLock::LockShared()
+{
+  int cpu = sched_getcpu();
+  size_t slot = cpu < 0 ? 0 : static_cast<size_t>(cpu) % cREADER_SLOTS;
+  while (true)
+  {
+    // Announce reader before checking for writer (writer sets flag before checking counters)
+    reader_counters[slot].count.fetch_add(1);
+    if (writer_active.load() == 0)
+    {
+      return slot;
+    }
+    UnlockShared(slot);
+    tFutex::Wait(writer_active, 1, cMAX_READER_WAIT);
+  }
+}
+
+void tReaderWriterLock::Lock()
+{
+  writer_mutex.lock();
+  writer_active.store(1);
+  for (tReaderCounter & counter : reader_counters)
+  {
+    while (true)
+    {
+      // Obtain value before checking counter (readers decrement counter before incrementing readers_left)
+      int left = readers_left.load();
+      if (counter.count.load() == 0)
+      {
+        break;
+      }
+      tFutex::Wait(readers_left, left, cMAX_WRITER_WAIT);
+    }
+  }
+}
+
+void tReaderWriterLock::Unlock()
+{
+  writer_active.store(0);
+  tFutex::Wake(writer_active, INT_MAX);
+  writer_mutex.unlock();
+}
+
+void tReaderWriterLock::WakeWriter()
+{
+  readers_left.fetch_add(1);
+  tFutex::Wake(readers_left);
+}
+
+tReaderWriterLock::tScopedLock::tScopedLock(tReaderWriterLock* lock, bool shared) :
+  lock(lock),
+  shared(shared),
+  acquired(false),
+  slot(0),
+  previous(innermost_lock)
+{
+  if (!lock)
+  {
+    return;
+  }
+
+  // Does current thread already hold this lock?
+  for (tScopedLock* held = previous; held; held = held->previous)
+  {
+    if (held->lock == lock)
+    {
+      if (held->shared && (!shared))
+      {
+        throw tRPCException(tFutureStatus::INVALID_CALL);
+      }
+      this->shared = held->shared;
+      innermost_lock = this;
+      return;
+    }
+  }
+
+  if (shared)
+  {
+    slot = lock->LockShared();
+  }
+  else
+  {
+    lock->Lock();
+  }
+  acquired = true;
+  innermost_lock = this;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
@@ -0,0 +1,228 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/internal/tReaderWriterLock.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tReaderWriterLock
+ *
+ * \b tReaderWriterLock
+ *
+ * Scalable reader-writer lock with distributed reader counters.
+ * Readers only modify a counter of the CPU core they run on - so concurrent
+ * readers on different cores do not contend on the same cache line.
+ * Writers are comparatively expensive as they need to check all counters.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__rpc_ports__internal__tReaderWriterLock_h__
+#define __plugins__rpc_ports__internal__tReaderWriterLock_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <array>
+#include <atomic>
+#include "rrlib/thread/tLock.h"
+#include "rrlib/util/tNoncopyable.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Distributed reader-writer lock
+/*!
+ * Scalable reader-writer lock with distributed reader counters.
+ * Readers only modify a counter of the CPU core they run on - so concurrent
+ * readers on different cores do not contend on the same cache line.
+ * Writers are comparatively expensive as they need to check all counters.
+ * Writers are preferred: New readers wait while a writer acquires or holds the lock.
+ *
+ * The lock is re-entrant when acquired via tScopedLock: A thread that already holds the lock
+ * (e.g. a server function calling another function of the same server) does not wait again.
+ * Acquiring the lock in exclusive mode while holding it in shared mode is not possible, however
+ * (tScopedLock throws INVALID_CALL).
+ *
+ * Used by server ports that execute const functions concurrently
+ * and non-const functions exclusively (tServerSynchronization::READER_WRITER).
+ */
+class tReaderWriterLock : private rrlib::util::tNoncopyable
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  tReaderWriterLock();
+
+  /*!
+   * Acquires lock in shared (reader) mode
+   *
+   * \return Reader slot that needs to be passed to UnlockShared()
+   */
+  size_t LockShared();
+
+  /*!
+   * Releases lock acquired in shared mode
+   *
+   * \param slot Reader slot returned by LockShared()
+   */
+  void UnlockShared(size_t slot)
+  {
+    if (reader_counters[slot].count.fetch_sub(1) == 1 && writer_active.load())
+    {
+      WakeWriter();
+    }
+  }
+
+  /*!
+   * Acquires lock in exclusive (writer) mode
+   */
+  void Lock();
+
+  /*!
+   * Releases lock acquired in exclusive mode
+   */
+  void Unlock();
+
+  /*!
+   * Holds lock while in scope.
+   * Scoped locks of a thread are tracked - so that the thread may re-enter a lock it already holds.
+   */
+  class tScopedLock : private rrlib::util::tNoncopyable
+  {
+  public:
+
+    /*!
+     * \param lock Lock to acquire (nothing is done if NULL)
+     * \param shared Acquire lock in shared mode? (exclusive otherwise)
+     * \throw tRPCException (INVALID_CALL) if current thread holds lock in shared mode and exclusive mode is requested
+     */
+    tScopedLock(tReaderWriterLock* lock, bool shared);
+
+    ~tScopedLock()
+    {
+      if (acquired)
+      {
+        if (shared)
+        {
+          lock->UnlockShared(slot);
+        }
+        else
+        {
+          lock->Unlock();
+        }
+      }
+      if (lock)
+      {
+        innermost_lock = previous;
+      }
+    }
+
+  private:
+
+    /*! Lock that is held (NULL if none) */
+    tReaderWriterLock* lock;
+
+    /*! Is lock held in shared mode? (for re-entered locks: mode that the lock is held in by the thread) */
+    bool shared;
+
+    /*! Was lock acquired by this object? (false if thread already held the lock) */
+    bool acquired;
+
+    /*! Reader slot (shared mode only) */
+    size_t slot;
+
+    /*! Scoped lock that was innermost lock of this thread before this one was created */
+    tScopedLock* previous;
+
+    /*! Innermost scoped lock of current thread (NULL if thread holds no lock) */
+    static thread_local tScopedLock* innermost_lock;
+  };
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  enum { cREADER_SLOTS = 64, cCACHE_LINE_SIZE = 64 };
+
+  /*!
+   * Reader counter - padded to the size of a cache line, so that no two counters share a cache line.
+   * (padded rather than over-aligned: lock is allocated with plain new, which does not respect extended alignment before C++17)
+   */
+  struct tReaderCounter
+  {
+    std::atomic<int> count;
+    char padding[cCACHE_LINE_SIZE - sizeof(std::atomic<int>)];
+  };
+  static_assert(sizeof(tReaderCounter) == cCACHE_LINE_SIZE, "Reader counters must occupy one cache line each");
+
+  /*! Number of readers holding the lock - one counter per reader slot (CPU core) */
+  std::array<tReaderCounter, cREADER_SLOTS> reader_counters;
+
+  /*! 1 while a writer acquires or holds the lock (waiting readers block on this word) */
+  std::atomic<int> writer_active;
+
+  /*! Incremented by readers leaving a counter while a writer is active (waiting writer blocks on this word) */
+  std::atomic<int> readers_left;
+
+  /*! Serializes writers */
+  rrlib::thread::tMutex writer_mutex;
+
+
+  /*!
+   * Wakes up writer waiting for readers to leave
+   */
+  void WakeWriter();
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -44,6 +44,7 @@
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "plugins/rpc_ports/internal/tValueBlock.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -70,14 +71,16 @@ namespace internal
 template <typename TReturn, bool PROMISE, bool SERIALIZABLE>
 struct tReturnValueSerialization
 {
-  inline static void Serialize(rrlib::serialization::tOutputStream& stream, TReturn& return_value, tCallStorage& storage)
+  inline static void Serialize(rrlib::serialization::tOutputStream& stream, TReturn& return_value, tCallStorage& storage, const tWireFormat& wire_format)
   {
-    stream << return_value;
+    tValueBlock<std::tuple<TReturn&>>::Serialize(stream, std::tuple<TReturn&>(return_value), wire_format);
   }
 
-  inline static void Deserialize(rrlib::serialization::tInputStream& stream, TReturn& return_value, tResponseSender& response_sender, uint8_t function_index, const rrlib::rtti::tType& rpc_interface_type)
+  inline static void Deserialize(rrlib::serialization::tInputStream& stream, TReturn& return_value, tResponseSender& response_sender, uint8_t function_index, const rrlib::rtti::tType& rpc_interface_type,
+                                 const tWireFormat& wire_format)
   {
-    stream >> return_value;
+    std::tuple<TReturn&> value(return_value);
+    tValueBlock<std::tuple<TReturn&>>::Deserialize(stream, value, wire_format);
   }
 };
 
@@ -85,12 +88,13 @@ struct tReturnValueSerialization
 template <typename TReturn>
 struct tReturnValueSerialization<TReturn, true, false>
 {
-  inline static void Serialize(rrlib::serialization::tOutputStream& stream, TReturn& return_value, tCallStorage& storage)
+  inline static void Serialize(rrlib::serialization::tOutputStream& stream, TReturn& return_value, tCallStorage& storage, const tWireFormat& wire_format)
   {
     stream << storage.GetCallId();
   }
 
-  inline static void Deserialize(rrlib::serialization::tInputStream& stream, TReturn& return_value, tResponseSender& response_sender, uint8_t function_index, const rrlib::rtti::tType& rpc_interface_type)
+  inline static void Deserialize(rrlib::serialization::tInputStream& stream, TReturn& return_value, tResponseSender& response_sender, uint8_t function_index, const rrlib::rtti::tType& rpc_interface_type,
+                                 const tWireFormat& wire_format)
   {
     tCallId call_id;
     stream >> call_id;
@@ -102,13 +106,14 @@ struct tReturnValueSerialization<TReturn, true, false>
 template <typename TReturn>
 struct tReturnValueSerialization<TReturn, true, true>
 {
-  inline static void Serialize(rrlib::serialization::tOutputStream& stream, TReturn& return_value, tCallStorage& storage)
+  inline static void Serialize(rrlib::serialization::tOutputStream& stream, TReturn& return_value, tCallStorage& storage, const tWireFormat& wire_format)
   {
     stream << storage.GetCallId();
     stream << return_value;
   }
 
-  inline static void Deserialize(rrlib::serialization::tInputStream& stream, TReturn& return_value, tResponseSender& response_sender, uint8_t function_index, const rrlib::rtti::tType& rpc_interface_type)
+  inline static void Deserialize(rrlib::serialization::tInputStream& stream, TReturn& return_value, tResponseSender& response_sender, uint8_t function_index, const rrlib::rtti::tType& rpc_interface_type,
+                                 const tWireFormat& wire_format)
   {
     tCallId call_id;
     stream >> call_id;
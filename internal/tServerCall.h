@@ -0,0 +1,407 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/internal/tServerCall.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tServerCall
+ *
+ * \b tServerCall
+ *
+ * Call to a function of a server in the same runtime environment.
+ * Calls are only stored in this class if they are passed to the executor
+ * of the server port (see tExecutor) - otherwise, functions are called directly
+ * using the static Call() function.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__rpc_ports__internal__tServerCall_h__
+#define __plugins__rpc_ports__internal__tServerCall_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <memory>
+#include "rrlib/util/tIntegerSequence.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/tFuture.h"
+#include "plugins/rpc_ports/internal/tReaderWriterLock.h"
+#include "plugins/rpc_ports/internal/tServerGuard.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+/*!
+ * Type of future for result of server function with return type TReturn
+ */
+template <typename TReturn>
+struct tServerCallFuture
+{
+  typedef typename std::conditional<std::is_base_of<tIsFuture, TReturn>::value, TReturn, tFuture<TReturn>>::type type;
+};
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Base class for calls that are passed to executors
+/*!
+ * Base class for calls that are passed to executors
+ */
+class tExecutableCall : public tAbstractCall
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * Executes call
+   *
+   * \param self Pointer to storage that this call is stored in (call may hold on to it until call has completed)
+   */
+  virtual void Execute(tCallStorage::tPointer && self) = 0;
+
+  virtual void Serialize(rrlib::serialization::tOutputStream& stream, tWireFormat& wire_format) override
+  {
+    throw std::runtime_error("Calls to local servers cannot be serialized");
+  }
+};
+
+//! Call to local server
+/*!
+ * Call to a function of a server in the same runtime environment.
+ * Stores the parameters and the result of the call.
+ * Functions returning a future are supported: the call then completes when the returned future does.
+ *
+ * \tparam TInterface RPC interface type
+ * \tparam TFunction Type of member function pointer
+ * \tparam TReturn Return type of function
+ * \tparam TArgs Parameter types of function
+ */
+template <typename TInterface, typename TFunction, typename TReturn, typename ... TArgs>
+class tServerCall : public tExecutableCall, public tResponseHandler<typename tServerCallFuture<TReturn>::type::tValue>
+{
+  typedef std::tuple<typename std::decay<TArgs>::type...> tParameterTuple;
+
+  enum { cNATIVE_FUTURE_FUNCTION = std::is_base_of<tIsFuture, TReturn>::value };
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*! Future for result of call */
+  typedef typename tServerCallFuture<TReturn>::type tResponseFuture;
+
+  /*! Value type of future */
+  typedef typename tResponseFuture::tValue tValue;
+
+  template <typename ... TCallArgs>
+  tServerCall(tCallStorage& storage, const std::shared_ptr<tServerGuard>& server_guard, tReaderWriterLock* server_lock, TInterface& server_interface, TFunction function, TCallArgs && ... args) :
+    storage(storage),
+    server_guard(server_guard),
+    server_lock(server_lock),
+    server_interface(server_interface),
+    function(function),
+    parameters(std::forward<TCallArgs>(args)...),
+    result_buffer(),
+    inner_future(),
+    self()
+  {
+    storage.call_type = tCallType::UNSPECIFIED;
+    storage.future_status.store(static_cast<int>(tFutureStatus::PENDING));
+  }
+
+  /*!
+   * Calls function directly
+   * (if server has a lock, it is held while function is called - in shared mode for const functions)
+   *
+   * \param server_lock Lock of server (NULL if server does not synchronize calls)
+   * \param server_interface Server interface to call function on
+   * \param function Function to call
+   * \param args Arguments for function call
+   * \return Future for result (ready immediately - unless function returns a pending future)
+   */
+  template <typename ... TCallArgs>
+  static tResponseFuture Call(tReaderWriterLock* server_lock, TInterface& server_interface, TFunction function, TCallArgs && ... args)
+  {
+    try
+    {
+      tReaderWriterLock::tScopedLock lock(server_lock, std::is_const<TInterface>::value);
+      return CallImplementation(server_interface, function, std::forward<TCallArgs>(args)...);
+    }
+    catch (const tRPCException& e)
+    {
+      return tResponseFuture(e.GetType());
+    }
+  }
+
+  virtual void Execute(tCallStorage::tPointer && self) override
+  {
+    this->self = std::move(self);
+    if (std::chrono::steady_clock::now() > storage.GetDeadline())
+    {
+      // Caller is not waiting for result anymore: drop call
+      Finish(tResult<tValue>(tFutureStatus::TIMEOUT));
+      return;
+    }
+
+    tResponseFuture result;
+    {
+      tServerGuard::tAccess access(*server_guard);
+      if (!access.Granted())
+      {
+        result = tResponseFuture(tFutureStatus::NO_CONNECTION); // server port was deleted while call was queued
+      }
+      else
+      {
+        try
+        {
+          result = CallWithParameters(typename rrlib::util::tIntegerSequenceGenerator<sizeof...(TArgs)>::type());
+        }
+        catch (const std::exception& e)
+        {
+          FINROC_LOG_PRINT(WARNING, "Server function threw exception: ", e);
+          result = tResponseFuture(tFutureStatus::BROKEN_PROMISE);
+        }
+      }
+    }
+
+    if (!result.storage)
+    {
+      Finish(result.TryGet(rrlib::time::tDuration::zero()));
+      return;
+    }
+    inner_future = std::move(result);
+    if (!inner_future.storage->AttachResponseHandler(this))
+    {
+      Finish(inner_future.TryGet(rrlib::time::tDuration::zero()));
+    }
+  }
+
+  /*!
+   * \return Future for result of this call
+   */
+  tResponseFuture GetFuture()
+  {
+    return tResponseFuture(storage.ObtainFuturePointer(), result_buffer);
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Storage this call was allocated in */
+  tCallStorage& storage;
+
+  /*! Guard of server port (server interface and lock are only accessed while it grants access) */
+  std::shared_ptr<tServerGuard> server_guard;
+
+  /*! Lock of server (NULL if server does not synchronize calls) */
+  tReaderWriterLock* server_lock;
+
+  /*! Server interface to call function on */
+  TInterface& server_interface;
+
+  /*! Function to call */
+  TFunction function;
+
+  /*! Parameters of call */
+  tParameterTuple parameters;
+
+  /*! Result will be stored here */
+  tValue result_buffer;
+
+  /*! Pending future returned by function (functions returning futures) */
+  tResponseFuture inner_future;
+
+  /*! Pointer to own storage (held until result is set) */
+  tCallStorage::tPointer self;
+
+
+  template <bool NATIVE_FUTURE_FUNCTION = cNATIVE_FUTURE_FUNCTION, typename ... TCallArgs>
+  static typename std::enable_if<NATIVE_FUTURE_FUNCTION, tResponseFuture>::type CallImplementation(TInterface& server_interface, TFunction function, TCallArgs && ... args)
+  {
+    return (server_interface.*function)(std::forward<TCallArgs>(args)...);
+  }
+
+  template <bool NATIVE_FUTURE_FUNCTION = cNATIVE_FUTURE_FUNCTION, typename ... TCallArgs>
+  static typename std::enable_if < !NATIVE_FUTURE_FUNCTION, tResponseFuture >::type CallImplementation(TInterface& server_interface, TFunction function, TCallArgs && ... args)
+  {
+    // Future is ready immediately - and stores result inline
+    return tResponseFuture(tFutureStatus::READY, (server_interface.*function)(std::forward<TCallArgs>(args)...));
+  }
+
+  template <int ... SEQUENCE>
+  tResponseFuture CallWithParameters(rrlib::util::tIntegerSequence<SEQUENCE...> sequence)
+  {
+    return Call(server_lock, server_interface, function, std::move(std::get<SEQUENCE>(parameters))...);
+  }
+
+  /*!
+   * Sets result of this call and releases its storage
+   * (call might be deleted when this method returns)
+   */
+  void Finish(tResult<tValue> && result)
+  {
+    tCallStorage::tPointer self_pointer = std::move(self);
+    if (!result.Ok())
+    {
+      storage.SetException(result.GetStatus());
+      return;
+    }
+    result_buffer = std::move(result.GetValue());
+    tAbstractResponseHandler* handler = storage.Complete(tFutureStatus::READY);
+    if (handler)
+    {
+      static_cast<tResponseHandler<tValue>*>(handler)->HandleResponse(std::move(result_buffer));
+    }
+  }
+
+  virtual void HandleException(tFutureStatus exception_type) override
+  {
+    Finish(tResult<tValue>(exception_type));
+  }
+
+  virtual void HandleResponse(tValue call_result) override
+  {
+    Finish(tResult<tValue>(std::move(call_result)));
+  }
+};
+
+// Specialization for functions without return value (messages)
+template <typename TInterface, typename TFunction, typename ... TArgs>
+class tServerCall<TInterface, TFunction, void, TArgs...> : public tExecutableCall
+{
+  typedef std::tuple<typename std::decay<TArgs>::type...> tParameterTuple;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  template <typename ... TCallArgs>
+  tServerCall(tCallStorage& storage, const std::shared_ptr<tServerGuard>& server_guard, tReaderWriterLock* server_lock, TInterface& server_interface, TFunction function, TCallArgs && ... args) :
+    server_guard(server_guard),
+    server_lock(server_lock),
+    server_interface(server_interface),
+    function(function),
+    parameters(std::forward<TCallArgs>(args)...)
+  {
+    storage.call_type = tCallType::UNSPECIFIED;
+  }
+
+  /*!
+   * Calls function directly (ignoring any exceptions)
+   * (if server has a lock, it is held while function is called - in shared mode for const functions)
+   *
+   * \param server_lock Lock of server (NULL if server does not synchronize calls)
+   * \param server_interface Server interface to call function on
+   * \param function Function to call
+   * \param args Arguments for function call
+   */
+  template <typename ... TCallArgs>
+  static void Call(tReaderWriterLock* server_lock, TInterface& server_interface, TFunction function, TCallArgs && ... args)
+  {
+    try
+    {
+      tReaderWriterLock::tScopedLock lock(server_lock, std::is_const<TInterface>::value);
+      (server_interface.*function)(std::forward<TCallArgs>(args)...);
+    }
+    catch (const tRPCException& e)
+    {
+      FINROC_LOG_PRINT_STATIC(DEBUG, e);
+    }
+  }
+
+  virtual void Execute(tCallStorage::tPointer && self) override
+  {
+    tServerGuard::tAccess access(*server_guard);
+    if (!access.Granted())
+    {
+      return; // server port was deleted while call was queued
+    }
+    try
+    {
+      CallWithParameters(typename rrlib::util::tIntegerSequenceGenerator<sizeof...(TArgs)>::type());
+    }
+    catch (const std::exception& e)
+    {
+      FINROC_LOG_PRINT(WARNING, "Server function threw exception: ", e);
+    }
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Guard of server port (server interface and lock are only accessed while it grants access) */
+  std::shared_ptr<tServerGuard> server_guard;
+
+  /*! Lock of server (NULL if server does not synchronize calls) */
+  tReaderWriterLock* server_lock;
+
+  /*! Server interface to call function on */
+  TInterface& server_interface;
+
+  /*! Function to call */
+  TFunction function;
+
+  /*! Parameters of call */
+  tParameterTuple parameters;
+
+
+  template <int ... SEQUENCE>
+  void CallWithParameters(rrlib::util::tIntegerSequence<SEQUENCE...> sequence)
+  {
+    Call(server_lock, server_interface, function, std::move(std::get<SEQUENCE>(parameters))...);
+  }
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -0,0 +1,103 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/internal/tServerGuard.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/internal/tServerGuard.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/internal/tFutex.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+/*! Maximum time Invalidate() blocks before checking accesses again */
+static const rrlib::time::tDuration cMAX_INVALIDATE_WAIT = std::chrono::milliseconds(100);
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+tServerGuard::tAccess::tAccess(tServerGuard& guard) :
+  guard(guard),
+  granted((guard.state.fetch_add(1) & cDELETED_FLAG) == 0)
+{}
+
+tServerGuard::tAccess::~tAccess()
+{
+  if (guard.state.fetch_sub(1) & cDELETED_FLAG)
+  {
+    tFutex::Wake(guard.state);
+  }
+}
+
+void tServerGuard::Invalidate()
+{
+  int current_state = state.fetch_or(cDELETED_FLAG) | cDELETED_FLAG;
+  while (current_state != cDELETED_FLAG)
+  {
+    tFutex::Wait(state, current_state, cMAX_INVALIDATE_WAIT);
+    current_state = state.load();
+  }
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
@@ -0,0 +1,141 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/internal/tServerGuard.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tServerGuard
+ *
+ * \b tServerGuard
+ *
+ * Tracks whether a server port still exists - for calls to the server that are queued in an executor.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__rpc_ports__internal__tServerGuard_h__
+#define __plugins__rpc_ports__internal__tServerGuard_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <atomic>
+#include "rrlib/util/tNoncopyable.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Guard for server ports with executor
+/*!
+ * Tracks whether a server port still exists - for calls to the server that are queued in an executor.
+ * Queued calls share ownership of the guard (not of the port): Before they access server interface or
+ * server lock, they obtain access via tAccess - which fails if the port has been deleted in the meantime.
+ * When the port is deleted, Invalidate() waits for calls that are currently accessing the server.
+ */
+class tServerGuard : private rrlib::util::tNoncopyable
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  tServerGuard() :
+    state(0)
+  {}
+
+  /*!
+   * Holds access to server while in scope (port is not deleted before access is released)
+   */
+  class tAccess : private rrlib::util::tNoncopyable
+  {
+  public:
+
+    explicit tAccess(tServerGuard& guard);
+
+    ~tAccess();
+
+    /*!
+     * \return True if server may be accessed (false if port has been deleted)
+     */
+    bool Granted() const
+    {
+      return granted;
+    }
+
+  private:
+
+    /*! Guard that access was requested from */
+    tServerGuard& guard;
+
+    /*! Was access granted? */
+    bool granted;
+  };
+
+  /*!
+   * Marks server port as deleted (called when port is deleted).
+   * Returns when no thread accesses the server anymore
+   * (must therefore not be called by server functions executed via tAccess - e.g. to delete their own port).
+   */
+  void Invalidate();
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Flag in state that is set when port has been deleted */
+  enum { cDELETED_FLAG = 1 << 30 };
+
+  /*! Number of accesses (including requested ones that are not granted) + cDELETED_FLAG when port has been deleted */
+  std::atomic<int> state;
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -0,0 +1,408 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/internal/tTimerWheel.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/internal/tTimerWheel.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <limits>
+#include "rrlib/thread/tThread.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/internal/tCallStorage.h"
+#include "plugins/rpc_ports/internal/tFutex.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+/*! Maximum time wheel's thread blocks while wheel is empty (before checking whether it is to stop) */
+static const rrlib::time::tDuration cMAX_IDLE_WAIT = std::chrono::seconds(1);
+
+/*! Maximum time wheel's thread blocks while removed calls wait for their addition to be published */
+static const rrlib::time::tDuration cDEFERRED_REMOVAL_WAIT = std::chrono::milliseconds(1);
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+class tTimerWheel::tWheelThread : public rrlib::thread::tThread
+{
+public:
+  tWheelThread(tTimerWheel& wheel) :
+    rrlib::thread::tThread("RPC Timer Wheel"),
+    wheel(wheel)
+  {}
+
+  virtual void Run() override
+  {
+    wheel.Run();
+  }
+
+private:
+
+  /*! Wheel whose ticks this thread processes */
+  tTimerWheel& wheel;
+};
+
+tTimerWheel::tTimerWheel() :
+  added_calls(NULL),
+  removed_calls(NULL),
+  deferred_removed_calls(NULL),
+  wake_up_counter(0),
+  wake_up_tick(0),
+  slots(),
+  current_tick(GetCurrentTick()),
+  call_count(0),
+  published_call_count(0),
+  expired_calls(),
+  stop(false),
+  thread()
+{
+  thread = std::static_pointer_cast<tWheelThread>((new tWheelThread(*this))->GetSharedPtr());
+  thread->Start();
+}
+
+tTimerWheel::~tTimerWheel()
+{
+  stop.store(true);
+  wake_up_counter.fetch_add(1);
+  tFutex::Wake(wake_up_counter);
+  thread->Join();
+
+  for (size_t level = 0; level < cLEVELS; level++)
+  {
+    for (size_t slot = 0; slot < cSLOTS; slot++)
+    {
+      for (tCallStorage* call = slots[level][slot]; call; call = call->timer_wheel_next)
+      {
+        call->in_timer_wheel.store(false);
+      }
+    }
+  }
+  for (tCallStorage* call = added_calls.load(); call; call = call->timer_wheel_next)
+  {
+    call->in_timer_wheel.store(false);
+  }
+}
+
+void tTimerWheel::Add(tCallStorage& call)
+{
+  tCallStorage::tDeadline deadline = call.GetDeadline();
+  if (deadline == tCallStorage::tDeadline::max())
+  {
+    return;
+  }
+  uint64_t deadline_tick = std::chrono::duration_cast<std::chrono::milliseconds>(deadline.time_since_epoch()).count() + 1; // round up: calls never expire early
+
+  tTimerWheel& wheel = GetInstance();
+  call.ObtainFuturePointer().release(); // reference is held by wheel until call is removed
+  call.timer_wheel_tick = deadline_tick;
+  call.in_timer_wheel.store(true);
+  tCallStorage* old_head = wheel.added_calls.load(std::memory_order_relaxed);
+  do
+  {
+    call.timer_wheel_next = old_head;
+  }
+  while (!wheel.added_calls.compare_exchange_weak(old_head, &call));
+
+  // Wake up wheel's thread only if it sleeps beyond this call's deadline (wheel's thread sets wake_up_tick before checking added_calls)
+  if (deadline_tick < wheel.wake_up_tick.load())
+  {
+    wheel.wake_up_counter.fetch_add(1);
+    tFutex::Wake(wheel.wake_up_counter);
+  }
+}
+
+void tTimerWheel::Cascade(size_t level, size_t slot)
+{
+  tCallStorage* call = slots[level][slot];
+  slots[level][slot] = NULL;
+  while (call)
+  {
+    tCallStorage* next = call->timer_wheel_next;
+    Insert(*call);
+    call = next;
+  }
+}
+
+size_t tTimerWheel::GetCallCount()
+{
+  return GetInstance().published_call_count.load();
+}
+
+uint64_t tTimerWheel::GetCurrentTick()
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+tTimerWheel& tTimerWheel::GetInstance()
+{
+  static tTimerWheel instance;
+  return instance;
+}
+
+uint64_t tTimerWheel::GetNextEventTick() const
+{
+  uint64_t next_cascade = (current_tick | cSLOT_MASK) + 1;
+  for (uint64_t tick = current_tick + 1; tick < next_cascade; tick++)
+  {
+    if (slots[0][tick & cSLOT_MASK])
+    {
+      return tick;
+    }
+  }
+  return next_cascade;
+}
+
+void tTimerWheel::Insert(tCallStorage& call)
+{
+  uint64_t expiry_tick = std::min(call.timer_wheel_tick, current_tick + cMAX_TICKS);
+  uint64_t delta = expiry_tick > current_tick ? expiry_tick - current_tick : 0;
+  if (delta == 0)
+  {
+    expiry_tick = current_tick; // only happens while cascading: slot of current tick is processed next
+  }
+  size_t level = 0;
+  while (level < cLEVELS - 1 && delta >= (1ull << ((level + 1) * cSLOT_BITS)))
+  {
+    level++;
+  }
+
+  tCallStorage*& head = slots[level][(expiry_tick >> (level * cSLOT_BITS)) & cSLOT_MASK];
+  call.timer_wheel_slot = &head;
+  call.timer_wheel_prev = NULL;
+  call.timer_wheel_next = head;
+  if (head)
+  {
+    head->timer_wheel_prev = &call;
+  }
+  head = &call;
+}
+
+void tTimerWheel::ProcessAddedAndRemovedCalls()
+{
+  // Take removed calls first: calls are always added before they are removed - so they are in the wheel after adding calls below
+  // unless Add() has not published them yet (removal is deferred then)
+  tCallStorage* removed = removed_calls.exchange(NULL);
+  if (deferred_removed_calls)
+  {
+    tCallStorage* last = deferred_removed_calls;
+    while (last->timer_wheel_next_removed)
+    {
+      last = last->timer_wheel_next_removed;
+    }
+    last->timer_wheel_next_removed = removed;
+    removed = deferred_removed_calls;
+    deferred_removed_calls = NULL;
+  }
+  tCallStorage* added = added_calls.exchange(NULL);
+  if (added && call_count == 0)
+  {
+    current_tick = GetCurrentTick();
+  }
+  while (added)
+  {
+    tCallStorage* next = added->timer_wheel_next;
+    added->timer_wheel_tick = std::max(added->timer_wheel_tick, current_tick + 1);
+    Insert(*added);
+    added->timer_wheel_added = true;
+    call_count++;
+    added = next;
+  }
+  while (removed)
+  {
+    tCallStorage* next = removed->timer_wheel_next_removed;
+    if (!removed->timer_wheel_added)
+    {
+      removed->timer_wheel_next_removed = deferred_removed_calls;
+      deferred_removed_calls = removed;
+      removed = next;
+      continue;
+    }
+    removed->timer_wheel_next_removed = NULL;
+    removed->timer_wheel_added = false;
+    if (removed->timer_wheel_slot)
+    {
+      Unlink(*removed);
+    }
+    call_count--;
+    removed->ReleaseLock<true>();
+    removed = next;
+  }
+}
+
+void tTimerWheel::Remove(tCallStorage& call)
+{
+  if (!call.in_timer_wheel.exchange(false))
+  {
+    return; // expired or removed concurrently
+  }
+  tTimerWheel& wheel = GetInstance();
+  tCallStorage* old_head = wheel.removed_calls.load(std::memory_order_relaxed);
+  do
+  {
+    call.timer_wheel_next_removed = old_head;
+  }
+  while (!wheel.removed_calls.compare_exchange_weak(old_head, &call));
+}
+
+void tTimerWheel::Run()
+{
+  while (!stop.load())
+  {
+    int counter = wake_up_counter.load();
+    ProcessAddedAndRemovedCalls();
+
+    uint64_t now = GetCurrentTick();
+    while (current_tick < now && call_count > 0)
+    {
+      current_tick++;
+
+      // Cascade calls from higher levels whenever the level below wraps around
+      for (size_t level = 1; level < cLEVELS; level++)
+      {
+        if ((current_tick & ((1ull << (level * cSLOT_BITS)) - 1)) != 0)
+        {
+          break;
+        }
+        Cascade(level, (current_tick >> (level * cSLOT_BITS)) & cSLOT_MASK);
+      }
+
+      // Collect expired calls
+      size_t slot = current_tick & cSLOT_MASK;
+      tCallStorage* call = slots[0][slot];
+      slots[0][slot] = NULL;
+      while (call)
+      {
+        tCallStorage* next = call->timer_wheel_next;
+        if (call->timer_wheel_tick <= current_tick)
+        {
+          call->timer_wheel_slot = NULL;
+          call->timer_wheel_next = NULL;
+          call->timer_wheel_prev = NULL;
+          if (call->in_timer_wheel.exchange(false))
+          {
+            call->timer_wheel_added = false;
+            call_count--;
+            expired_calls.push_back(call);
+          } // otherwise, call was removed concurrently and is released with removed calls
+        }
+        else
+        {
+          Insert(*call); // deadline was beyond range of wheel
+        }
+        call = next;
+      }
+    }
+
+    for (tCallStorage* call : expired_calls)
+    {
+      if (call->GetFutureStatus() == tFutureStatus::PENDING)
+      {
+        call->SetException(tFutureStatus::TIMEOUT);
+      }
+      call->ReleaseLock<true>();
+    }
+    expired_calls.clear();
+    published_call_count.store(call_count);
+
+    // Sleep until next tick with calls to process (announce tick before checking for added calls - see Add())
+    uint64_t next_tick = call_count ? GetNextEventTick() : std::numeric_limits<uint64_t>::max();
+    wake_up_tick.store(next_tick);
+    if (added_calls.load() == NULL)
+    {
+      rrlib::time::tDuration timeout = cMAX_IDLE_WAIT;
+      if (call_count)
+      {
+        now = GetCurrentTick();
+        timeout = next_tick > now ? std::chrono::milliseconds(next_tick - now) : rrlib::time::tDuration::zero();
+      }
+      if (deferred_removed_calls)
+      {
+        timeout = std::min(timeout, cDEFERRED_REMOVAL_WAIT); // Add() publishes call shortly - without necessarily waking this thread
+      }
+      tFutex::Wait(wake_up_counter, counter, timeout);
+    }
+    wake_up_tick.store(0);
+  }
+}
+
+void tTimerWheel::Unlink(tCallStorage& call)
+{
+  if (call.timer_wheel_prev)
+  {
+    call.timer_wheel_prev->timer_wheel_next = call.timer_wheel_next;
+  }
+  else
+  {
+    *call.timer_wheel_slot = call.timer_wheel_next;
+  }
+  if (call.timer_wheel_next)
+  {
+    call.timer_wheel_next->timer_wheel_prev = call.timer_wheel_prev;
+  }
+  call.timer_wheel_next = NULL;
+  call.timer_wheel_prev = NULL;
+  call.timer_wheel_slot = NULL;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
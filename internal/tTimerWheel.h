@@ -0,0 +1,239 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/internal/tTimerWheel.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tTimerWheel
+ *
+ * \b tTimerWheel
+ *
+ * Hierarchical timer wheel that tracks all calls sent to other runtime environments
+ * which expect a response. Calls that have not completed when their deadline passes
+ * are completed with tFutureStatus::TIMEOUT - so that futures and response handlers
+ * of lost calls are notified.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__rpc_ports__internal__tTimerWheel_h__
+#define __plugins__rpc_ports__internal__tTimerWheel_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tNoncopyable.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+class tCallStorage;
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Timer wheel for call deadlines
+/*!
+ * Hierarchical timer wheel that tracks all calls sent to other runtime environments
+ * which expect a response. Calls that have not completed when their deadline passes
+ * are completed with tFutureStatus::TIMEOUT - so that futures and response handlers
+ * of lost calls are notified.
+ *
+ * The wheel has cLEVELS levels with cSLOTS slots each. Slots of the lowest level
+ * cover one tick (one millisecond) - slots of each higher level cover all slots
+ * of the level below. Calls are linked intrusively into doubly-linked slot lists
+ * via their storage objects - so adding and removing calls is O(1) and does not allocate memory.
+ * When the lowest level wraps around, the calls in the next slot of the higher level
+ * are redistributed (cascaded) to the lower levels.
+ *
+ * The wheel holds a reference to each call it contains.
+ * All slot lists are only accessed by the wheel's thread - so no lock is required:
+ * Adding and removing calls pushes them onto lock-free queues (one CAS each) that the wheel's thread
+ * processes when it wakes up. The wheel's thread sleeps until the next tick with calls to expire
+ * (at most until the lowest level wraps around) - it is only woken up if a call is added
+ * that expires before that.
+ */
+class tTimerWheel : private rrlib::util::tNoncopyable
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * Adds call to timer wheel
+   * (must be called before call is sent - calls without deadline are ignored)
+   *
+   * \param call Call to add
+   */
+  static void Add(tCallStorage& call);
+
+  /*!
+   * Removes call from timer wheel - if it is contained
+   * (called when call completes; wheel's thread releases its reference to call when it wakes up next)
+   *
+   * \param call Call to remove
+   */
+  static void Remove(tCallStorage& call);
+
+  /*!
+   * (for tests and diagnostics)
+   *
+   * \return Number of calls that the wheel holds references to - as of the last time its thread woke up
+   */
+  static size_t GetCallCount();
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Number of levels and number of slots per level (must be power of two) */
+  enum { cLEVELS = 4, cSLOT_BITS = 6, cSLOTS = 1 << cSLOT_BITS, cSLOT_MASK = cSLOTS - 1 };
+
+  /*! Maximum distance (in ticks) of deadlines that can be stored in wheel (calls with deadlines further away are re-inserted when reached) */
+  static const uint64_t cMAX_TICKS = (1ull << (cLEVELS * cSLOT_BITS)) - 1;
+
+  /*! Thread that processes ticks (defined in tTimerWheel.cpp) */
+  class tWheelThread;
+
+  /*! Calls added since wheel's thread last woke up (linked via timer_wheel_next in reverse order) */
+  std::atomic<tCallStorage*> added_calls;
+
+  /*! Calls removed since wheel's thread last woke up (linked via timer_wheel_next_removed) */
+  std::atomic<tCallStorage*> removed_calls;
+
+  /*!
+   * Removed calls whose addition has not been processed yet (linked via timer_wheel_next_removed)
+   * (Remove() may be called after Add() set in_timer_wheel - but before the call was published in added_calls)
+   */
+  tCallStorage* deferred_removed_calls;
+
+  /*! Incremented to wake up wheel's thread (thread blocks on this word) */
+  std::atomic<int> wake_up_counter;
+
+  /*! Tick until which wheel's thread sleeps (0 while it is awake) - added calls expiring earlier wake it up */
+  std::atomic<uint64_t> wake_up_tick;
+
+  /*! Heads of slot lists */
+  tCallStorage* slots[cLEVELS][cSLOTS];
+
+  /*! Tick that has been processed last */
+  uint64_t current_tick;
+
+  /*! Number of calls in wheel */
+  size_t call_count;
+
+  /*! Copy of call_count for GetCallCount() */
+  std::atomic<size_t> published_call_count;
+
+  /*! Buffer for calls that expired in current tick */
+  std::vector<tCallStorage*> expired_calls;
+
+  /*! True when wheel's thread is to stop */
+  std::atomic<bool> stop;
+
+  /*! Thread that processes ticks */
+  std::shared_ptr<tWheelThread> thread;
+
+
+  tTimerWheel();
+
+  /*! Stops wheel's thread (calls left in wheel are not released - as this only happens on shutdown) */
+  ~tTimerWheel();
+
+  /*!
+   * Redistributes calls in specified slot to lower levels
+   *
+   * \param level Level of slot
+   * \param slot Index of slot
+   */
+  void Cascade(size_t level, size_t slot);
+
+  /*!
+   * \return Current tick of monotonic clock
+   */
+  static uint64_t GetCurrentTick();
+
+  /*!
+   * \return Singleton instance of wheel
+   */
+  static tTimerWheel& GetInstance();
+
+  /*!
+   * \return Next tick at which wheel's thread needs to process calls (next non-empty slot of the lowest level - or next cascade)
+   */
+  uint64_t GetNextEventTick() const;
+
+  /*!
+   * Inserts call into slot that corresponds to its expiry tick (relative to current_tick)
+   *
+   * \param call Call to insert
+   */
+  void Insert(tCallStorage& call);
+
+  /*!
+   * Inserts added calls into slots and releases removed ones
+   */
+  void ProcessAddedAndRemovedCalls();
+
+  /*!
+   * Main loop of wheel's thread
+   */
+  void Run();
+
+  /*!
+   * Unlinks call from its slot list
+   *
+   * \param call Call to unlink
+   */
+  void Unlink(tCallStorage& call);
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -0,0 +1,250 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/internal/tValueBlock.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tValueBlock
+ *
+ * \b tValueBlock
+ *
+ * Serializes a tuple of parameters or a return value - as memory image
+ * if all values are plain data types.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__rpc_ports__internal__tValueBlock_h__
+#define __plugins__rpc_ports__internal__tValueBlock_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tIntegerSequence.h"
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/tRPCBuffer.h"
+#include "plugins/rpc_ports/internal/tWireFormat.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+/*!
+ * Properties of a list of value types regarding raw block serialization
+ */
+template <typename ... T>
+struct tRawBlockTypes
+{
+  enum { cALL_TRIVIAL = 1, cANY_CLASS = 0, cSIZE = 0 };
+};
+
+template <typename T, typename ... TRest>
+struct tRawBlockTypes<T, TRest...>
+{
+  enum
+  {
+    /*! Can all values be transferred as memory image? (only types that opted in via tRawBlockSerializable - pointers cannot) */
+    cALL_TRIVIAL = tRawBlockSerializable<T>::value && std::is_trivially_copyable<T>::value && std::is_standard_layout<T>::value && (!std::is_pointer<T>::value) && (!std::is_member_pointer<T>::value) && tRawBlockTypes<TRest...>::cALL_TRIVIAL,
+
+    /*! Is any of the values a class/struct? (otherwise, stream operators are just as fast) */
+    cANY_CLASS = std::is_class<T>::value || tRawBlockTypes<TRest...>::cANY_CLASS,
+
+    /*! Size of raw block */
+    cSIZE = sizeof(T) + tRawBlockTypes<TRest...>::cSIZE
+  };
+};
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Block of values to serialize
+/*!
+ * Serializes the values in a tuple (parameters of a call, or a reference to a return value).
+ *
+ * If all values may be transferred as memory image (see tRawBlockSerializable - and at least one of them is a struct),
+ * they are preceded by a tWireFormat::tBlockTag with COMPACT encoding. If the wire format has raw blocks enabled,
+ * the memory images of the values are written directly - one after the other.
+ * Otherwise - and always with LEGACY encoding - values are serialized with their stream operators
+ * (producing the same bytes as the stream operator of the tuple).
+ * tRPCBuffer values are serialized via the wire format - so that transports can transfer their payloads without copying.
+ *
+ * Raw blocks are only accepted from peers with the same byte order and the same block size.
+ *
+ * \tparam TTuple std::tuple containing the values (may contain references)
+ */
+template <typename TTuple, typename TSequence = typename rrlib::util::tIntegerSequenceGenerator<std::tuple_size<TTuple>::value>::type>
+struct tValueBlock;
+
+template <typename TTuple, int ... SEQUENCE>
+struct tValueBlock<TTuple, rrlib::util::tIntegerSequence<SEQUENCE...>>
+{
+  typedef tRawBlockTypes<typename std::decay<typename std::tuple_element<SEQUENCE, TTuple>::type>::type...> tTypes;
+
+  /*! Are values preceded by a block tag with COMPACT encoding? */
+  enum { cTAGGED = tTypes::cALL_TRIVIAL && tTypes::cANY_CLASS };
+
+  /*! Size of raw block */
+  enum { cRAW_SIZE = tTypes::cSIZE };
+
+  static void Serialize(rrlib::serialization::tOutputStream& stream, const TTuple& values, const tWireFormat& wire_format)
+  {
+    SerializeImplementation(stream, values, wire_format);
+  }
+
+  /*!
+   * \throw std::runtime_error if a raw block was received from a peer with different byte order or layout
+   */
+  static void Deserialize(rrlib::serialization::tInputStream& stream, TTuple& values, const tWireFormat& wire_format)
+  {
+    DeserializeImplementation(stream, values, wire_format);
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  template <bool ENABLE = cTAGGED>
+  static typename std::enable_if<ENABLE, void>::type SerializeImplementation(rrlib::serialization::tOutputStream& stream, const TTuple& values, const tWireFormat& wire_format)
+  {
+    if (wire_format.GetEncoding() == tWireFormat::tEncoding::COMPACT)
+    {
+      if (wire_format.RawBlocksEnabled())
+      {
+        stream.WriteByte(static_cast<int8_t>(tWireFormat::GetNativeRawBlockTag()));
+        tWireFormat::WriteVarint(stream, cRAW_SIZE);
+        int write[] = { 0, (WriteRaw(stream, std::get<SEQUENCE>(values)), 0)... };
+        (void)write;
+        return;
+      }
+      stream.WriteByte(static_cast<int8_t>(tWireFormat::cFIELDWISE_BLOCK));
+    }
+    SerializeFieldwise(stream, values, wire_format);
+  }
+
+  template <bool DISABLE = cTAGGED>
+  static typename std::enable_if < !DISABLE, void >::type SerializeImplementation(rrlib::serialization::tOutputStream& stream, const TTuple& values, const tWireFormat& wire_format)
+  {
+    SerializeFieldwise(stream, values, wire_format);
+  }
+
+  template <bool ENABLE = cTAGGED>
+  static typename std::enable_if<ENABLE, void>::type DeserializeImplementation(rrlib::serialization::tInputStream& stream, TTuple& values, const tWireFormat& wire_format)
+  {
+    if (wire_format.GetEncoding() == tWireFormat::tEncoding::COMPACT)
+    {
+      uint8_t tag = static_cast<uint8_t>(stream.ReadByte());
+      if (tag != tWireFormat::cFIELDWISE_BLOCK)
+      {
+        if (tag != tWireFormat::GetNativeRawBlockTag() || tWireFormat::ReadVarint(stream) != cRAW_SIZE)
+        {
+          throw std::runtime_error("Raw value block from peer with different byte order or layout");
+        }
+        int read[] = { 0, (ReadRaw(stream, std::get<SEQUENCE>(values)), 0)... };
+        (void)read;
+        return;
+      }
+    }
+    DeserializeFieldwise(stream, values, wire_format);
+  }
+
+  template <bool DISABLE = cTAGGED>
+  static typename std::enable_if < !DISABLE, void >::type DeserializeImplementation(rrlib::serialization::tInputStream& stream, TTuple& values, const tWireFormat& wire_format)
+  {
+    DeserializeFieldwise(stream, values, wire_format);
+  }
+
+  static void SerializeFieldwise(rrlib::serialization::tOutputStream& stream, const TTuple& values, const tWireFormat& wire_format)
+  {
+    int serialize[] = { 0, (SerializeValue(stream, std::get<SEQUENCE>(values), wire_format), 0)... };
+    (void)serialize;
+  }
+
+  static void DeserializeFieldwise(rrlib::serialization::tInputStream& stream, TTuple& values, const tWireFormat& wire_format)
+  {
+    int deserialize[] = { 0, (DeserializeValue(stream, std::get<SEQUENCE>(values), wire_format), 0)... };
+    (void)deserialize;
+  }
+
+  template <typename T>
+  static void SerializeValue(rrlib::serialization::tOutputStream& stream, const T& value, const tWireFormat& wire_format)
+  {
+    stream << value;
+  }
+
+  static void SerializeValue(rrlib::serialization::tOutputStream& stream, const tRPCBuffer& value, const tWireFormat& wire_format)
+  {
+    wire_format.WriteBuffer(stream, value);
+  }
+
+  template <typename T>
+  static void DeserializeValue(rrlib::serialization::tInputStream& stream, T& value, const tWireFormat& wire_format)
+  {
+    stream >> value;
+  }
+
+  static void DeserializeValue(rrlib::serialization::tInputStream& stream, tRPCBuffer& value, const tWireFormat& wire_format)
+  {
+    value = wire_format.ReadBuffer(stream);
+  }
+
+  // Writes memory image of value (types must not contain padding - see tRawBlockSerializable)
+  template <typename T>
+  static void WriteRaw(rrlib::serialization::tOutputStream& stream, const T& value)
+  {
+    stream.Write(&value, sizeof(T));
+  }
+
+  template <typename T>
+  static void ReadRaw(rrlib::serialization::tInputStream& stream, T& value)
+  {
+    stream.ReadFully(&value, sizeof(T));
+  }
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -0,0 +1,111 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/internal/tWaitGroup.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/internal/tWaitGroup.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/internal/tFutex.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+void tWaitGroup::NotifyCompletion()
+{
+  int completed_count = completed.fetch_add(1) + 1;
+  if (completed_count == required_completions && waiting.load())
+  {
+    tFutex::Wake(completed);
+  }
+}
+
+bool tWaitGroup::Wait(const rrlib::time::tDuration& timeout)
+{
+  if (completed.load() >= required_completions)
+  {
+    return true;
+  }
+  tCallStorage::FlushCollectedCalls(); // calls we wait for might not have been sent yet
+
+  // Announce waiter before checking again (NotifyCompletion() increments counter before checking flag)
+  waiting.store(true);
+  std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+  int completed_count;
+  while ((completed_count = completed.load()) < required_completions)
+  {
+    rrlib::time::tDuration remaining = std::chrono::duration_cast<rrlib::time::tDuration>(deadline - std::chrono::steady_clock::now());
+    if (remaining <= rrlib::time::tDuration::zero())
+    {
+      return false;
+    }
+    tFutex::Wait(completed, completed_count, remaining);
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
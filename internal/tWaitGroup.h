@@ -0,0 +1,230 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/internal/tWaitGroup.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tWaitGroup
+ *
+ * \b tWaitGroup
+ *
+ * Single wait object shared by multiple futures.
+ * Used to wait for all or any of a set of futures (WhenAll(), WhenAny())
+ * with only a single wake-up of the waiting thread.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__rpc_ports__internal__tWaitGroup_h__
+#define __plugins__rpc_ports__internal__tWaitGroup_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <thread>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/tResponseHandler.h"
+#include "plugins/rpc_ports/internal/tCallStorage.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Wait object for multiple futures
+/*!
+ * Single wait object shared by multiple futures.
+ * Used to wait for all or any of a set of futures (WhenAll(), WhenAny())
+ * with only a single wake-up of the waiting thread.
+ *
+ * Futures are attached using tWaitGroupHandler objects.
+ */
+class tWaitGroup : private rrlib::util::tNoncopyable
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * \param required_completions Number of completed futures that Wait() waits for
+   */
+  tWaitGroup(int required_completions) :
+    completed(0),
+    required_completions(required_completions),
+    waiting(false)
+  {}
+
+  /*!
+   * Called whenever one of the futures completes.
+   * Wakes up waiting thread when the required number of futures has completed.
+   */
+  void NotifyCompletion();
+
+  /*!
+   * Blocks until the required number of futures has completed (or timeout expires)
+   *
+   * \param timeout Maximum time to wait
+   * \return True if required number of futures has completed
+   */
+  bool Wait(const rrlib::time::tDuration& timeout);
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Number of completed futures (thread waits on this word) */
+  std::atomic<int> completed;
+
+  /*! Number of completed futures that Wait() waits for */
+  const int required_completions;
+
+  /*! True while a thread is (about to be) blocked in Wait() */
+  std::atomic<bool> waiting;
+};
+
+/*!
+ * Attaches a future to a wait group.
+ * Receives the result of the future's call as response handler and puts it back
+ * into the future's result buffer - so that it can be obtained from the future without waiting.
+ * Detaches from the future when it is destructed.
+ */
+template <typename T>
+class tWaitGroupHandler : public tResponseHandler<T>
+{
+public:
+
+  tWaitGroupHandler() :
+    group(NULL),
+    storage(NULL),
+    result_buffer(NULL),
+    done(false)
+  {}
+
+  ~tWaitGroupHandler()
+  {
+    Detach();
+  }
+
+  /*!
+   * Attaches this handler to future (if future has not completed yet - otherwise notifies group immediately)
+   *
+   * \param group Wait group to notify
+   * \param future Future to attach to
+   */
+  void Attach(tWaitGroup& group, tFuture<T>& future)
+  {
+    this->group = &group;
+    if (!future.storage)
+    {
+      group.NotifyCompletion();
+      return;
+    }
+    if (future.callback_set)
+    {
+      throw std::runtime_error("Futures with callback cannot be waited for in groups");
+    }
+    result_buffer = future.result_buffer;
+    storage = future.storage.get();
+    if (!storage->AttachResponseHandler(this))
+    {
+      storage = NULL;
+      group.NotifyCompletion();
+    }
+  }
+
+  /*!
+   * Detaches this handler from future.
+   * If call completes concurrently, waits until handler has finished.
+   */
+  void Detach()
+  {
+    if (storage && (!storage->DetachResponseHandler(this)))
+    {
+      while (!done.load())
+      {
+        std::this_thread::yield();
+      }
+    }
+    storage = NULL;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Wait group to notify */
+  tWaitGroup* group;
+
+  /*! Storage of call that this handler is attached to (NULL if not attached) */
+  tCallStorage* storage;
+
+  /*! Result buffer of future */
+  T* result_buffer;
+
+  /*! Set when handler has been called (last access to this object in completing thread) */
+  std::atomic<bool> done;
+
+
+  virtual void HandleException(tFutureStatus exception_type) override
+  {
+    group->NotifyCompletion();
+    done.store(true);
+  }
+
+  virtual void HandleResponse(T call_result) override
+  {
+    *result_buffer = std::move(call_result);
+    group->NotifyCompletion();
+    done.store(true);
+  }
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
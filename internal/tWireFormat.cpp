@@ -0,0 +1,312 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/internal/tWireFormat.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/internal/tWireFormat.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <stdexcept>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/tRPCBuffer.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+/*! Maximum number of bytes of a 64 bit varint */
+static const size_t cMAX_VARINT_BYTES = 10;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+tWireFormat::tWireFormat(tEncoding encoding) :
+  encoding(encoding),
+  raw_blocks(false),
+  buffer_transfer(NULL),
+  outgoing_types(),
+  incoming_types()
+{}
+
+tWireFormat& tWireFormat::Legacy()
+{
+  static tWireFormat legacy(tEncoding::LEGACY);
+  return legacy;
+}
+
+tRPCBuffer tWireFormat::ReadBuffer(rrlib::serialization::tInputStream& stream) const
+{
+  uint64_t size;
+  stream >> size;
+  if (size > stream.Remaining())
+  {
+    // Corrupt or malicious data (payload must be contained in stream - this also guards against truncation to 32 bit size_t)
+    throw std::runtime_error("Invalid buffer size");
+  }
+  if (buffer_transfer)
+  {
+    return buffer_transfer->ReadBuffer(stream, size);
+  }
+  if (size == 0)
+  {
+    return tRPCBuffer();
+  }
+  std::vector<uint8_t> data(size);
+  stream.ReadFully(data.data(), size);
+  return tRPCBuffer(std::move(data));
+}
+
+tCallId tWireFormat::ReadCallId(rrlib::serialization::tInputStream& stream) const
+{
+  if (encoding == tEncoding::COMPACT)
+  {
+    return ReadVarint(stream);
+  }
+  tCallId call_id;
+  stream >> call_id;
+  return call_id;
+}
+
+rrlib::rtti::tType tWireFormat::ReadInterfaceType(rrlib::serialization::tInputStream& stream)
+{
+  rrlib::rtti::tType type;
+  if (encoding == tEncoding::LEGACY)
+  {
+    stream >> type;
+    return type;
+  }
+
+  uint64_t value = ReadVarint(stream);
+  uint64_t handle = value >> 1;
+  if (value & 1)
+  {
+    // New type: registered with the next free handle
+    if (handle != incoming_types.size())
+    {
+      throw std::runtime_error("Invalid interface type handle registration");
+    }
+    stream >> type;
+    incoming_types.push_back(type);
+    return type;
+  }
+  if (handle >= incoming_types.size())
+  {
+    throw std::runtime_error("Unknown interface type handle");
+  }
+  return incoming_types[handle];
+}
+
+void tWireFormat::ReadResponseStatus(rrlib::serialization::tInputStream& stream, bool& promise_response, tFutureStatus& status) const
+{
+  if (encoding == tEncoding::LEGACY)
+  {
+    stream >> promise_response;
+    stream >> status;
+    return;
+  }
+
+  uint8_t value = static_cast<uint8_t>(stream.ReadByte());
+  promise_response = value & 1;
+  if ((value >> 1) > static_cast<uint8_t>(tFutureStatus::INVALID_DATA_RECEIVED))
+  {
+    throw std::runtime_error("Invalid future status");
+  }
+  status = static_cast<tFutureStatus>(value >> 1);
+}
+
+rrlib::time::tDuration tWireFormat::ReadTimeout(rrlib::serialization::tInputStream& stream) const
+{
+  if (encoding == tEncoding::LEGACY)
+  {
+    rrlib::time::tDuration timeout;
+    stream >> timeout;
+    return timeout;
+  }
+
+  uint64_t value = ReadVarint(stream);
+  if (value == 0)
+  {
+    return rrlib::time::tDuration::max();
+  }
+  typedef std::chrono::microseconds::rep tRep;
+  uint64_t max_microseconds = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(rrlib::time::tDuration::max()).count());
+  if (value - 1 >= max_microseconds)
+  {
+    return rrlib::time::tDuration::max();
+  }
+  return std::chrono::duration_cast<rrlib::time::tDuration>(std::chrono::microseconds(static_cast<tRep>(value - 1)));
+}
+
+uint64_t tWireFormat::ReadVarint(rrlib::serialization::tInputStream& stream)
+{
+  uint64_t result = 0;
+  for (size_t i = 0; i < cMAX_VARINT_BYTES; i++)
+  {
+    uint8_t byte = static_cast<uint8_t>(stream.ReadByte());
+    if (i == cMAX_VARINT_BYTES - 1 && byte > 1)
+    {
+      break; // would not fit into 64 bits
+    }
+    result |= static_cast<uint64_t>(byte & 0x7F) << (7 * i);
+    if ((byte & 0x80) == 0)
+    {
+      return result;
+    }
+  }
+  throw std::runtime_error("Invalid varint");
+}
+
+void tWireFormat::Reset()
+{
+  outgoing_types.clear();
+  incoming_types.clear();
+}
+
+void tWireFormat::WriteBuffer(rrlib::serialization::tOutputStream& stream, const tRPCBuffer& buffer) const
+{
+  stream << static_cast<uint64_t>(buffer.Size());
+  WriteOpaqueBytes(stream, buffer);
+}
+
+void tWireFormat::WriteCallId(rrlib::serialization::tOutputStream& stream, tCallId call_id) const
+{
+  if (encoding == tEncoding::COMPACT)
+  {
+    WriteVarint(stream, call_id);
+  }
+  else
+  {
+    stream << call_id;
+  }
+}
+
+void tWireFormat::WriteInterfaceType(rrlib::serialization::tOutputStream& stream, const rrlib::rtti::tType& type)
+{
+  if (encoding == tEncoding::LEGACY)
+  {
+    stream << type;
+    return;
+  }
+
+  auto it = outgoing_types.find(type.GetUid());
+  if (it != outgoing_types.end())
+  {
+    WriteVarint(stream, it->second << 1);
+    return;
+  }
+  uint64_t handle = outgoing_types.size();
+  outgoing_types.emplace(type.GetUid(), handle);
+  WriteVarint(stream, (handle << 1) | 1);
+  stream << type;
+}
+
+void tWireFormat::WriteOpaqueBytes(rrlib::serialization::tOutputStream& stream, const tRPCBuffer& bytes) const
+{
+  if (buffer_transfer)
+  {
+    buffer_transfer->WriteBuffer(stream, bytes);
+  }
+  else
+  {
+    stream.Write(bytes.Data(), bytes.Size());
+  }
+}
+
+void tWireFormat::WriteResponseStatus(rrlib::serialization::tOutputStream& stream, bool promise_response, tFutureStatus status) const
+{
+  if (encoding == tEncoding::LEGACY)
+  {
+    stream << promise_response;
+    stream << status;
+    return;
+  }
+  stream.WriteByte(static_cast<int8_t>((static_cast<uint8_t>(status) << 1) | (promise_response ? 1 : 0)));
+}
+
+void tWireFormat::WriteTimeout(rrlib::serialization::tOutputStream& stream, const rrlib::time::tDuration& timeout) const
+{
+  if (encoding == tEncoding::LEGACY)
+  {
+    stream << timeout;
+    return;
+  }
+
+  if (timeout == rrlib::time::tDuration::max())
+  {
+    WriteVarint(stream, 0);
+    return;
+  }
+  std::chrono::microseconds microseconds = std::chrono::duration_cast<std::chrono::microseconds>(timeout);
+  WriteVarint(stream, microseconds.count() <= 0 ? 1 : static_cast<uint64_t>(microseconds.count()) + 1);
+}
+
+void tWireFormat::WriteVarint(rrlib::serialization::tOutputStream& stream, uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    stream.WriteByte(static_cast<int8_t>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  stream.WriteByte(static_cast<int8_t>(value));
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
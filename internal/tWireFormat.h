@@ -0,0 +1,338 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/internal/tWireFormat.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tWireFormat
+ *
+ * \b tWireFormat
+ *
+ * Encoding of the header fields of serialized RPC calls for one network connection.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__rpc_ports__internal__tWireFormat_h__
+#define __plugins__rpc_ports__internal__tWireFormat_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/serialization/serialization.h"
+#include "rrlib/time/time.h"
+#include <unordered_map>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/definitions.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+class tRPCBuffer;
+
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Wire format of RPC call headers
+/*!
+ * Encodes the header fields of serialized RPC calls (interface type, call id, timeout, response status).
+ * The function index is always written as a single byte and parameters/return values are not affected.
+ *
+ * LEGACY is the original format: full rrlib::rtti::tType, 64 bit call id, tDuration timeout,
+ * promise flag and status as separate values.
+ *
+ * COMPACT is meant for small calls that are dominated by header size:
+ *  - Interface types are registered once per connection: the first call with a type
+ *    transfers the type together with a new handle; subsequent calls only transfer the handle (varint).
+ *  - Call ids are varints.
+ *  - Timeouts are varints in microseconds (0 = no deadline, otherwise remaining time + 1).
+ *  - Promise flag and status are packed into one byte.
+ *  - Parameters and return values of plain data types (see tRawBlockSerializable and tValueBlock) are preceded by a tBlockTag.
+ *    If raw blocks are enabled, they are transferred as one contiguous memory image.
+ *
+ * With both encodings, tRPCBuffer payloads are written as 64 bit size followed by the payload bytes.
+ * A transport may register a tBufferTransfer to produce/consume these bytes without copying them.
+ * Streams that calls are deserialized from must contain the complete frame (message) that is read:
+ * Buffer sizes are validated against tInputStream::Remaining() - which only covers the stream's current buffer.
+ *
+ * Both sides of a connection must agree on the encoding (e.g. during connection setup).
+ * Since the type tables are stateful, one object is required per connection and
+ * calls must be deserialized in the order they were serialized.
+ * Objects are not thread-safe: serialization and deserialization may happen in
+ * different threads, but each side must only be used by one thread at a time.
+ */
+class tWireFormat
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  enum class tEncoding
+  {
+    LEGACY, //!< original format
+    COMPACT //!< compact format with varints and per-connection interface type table
+  };
+
+  /*!
+   * Tag written before blocks of trivially copyable parameters/return values (COMPACT encoding only)
+   */
+  enum tBlockTag
+  {
+    cFIELDWISE_BLOCK,         //!< values are serialized with their stream operators
+    cRAW_LITTLE_ENDIAN_BLOCK, //!< memory image of values written by a little endian peer
+    cRAW_BIG_ENDIAN_BLOCK     //!< memory image of values written by a big endian peer
+  };
+
+  /*!
+   * Zero-copy transfer of tRPCBuffer payloads - implemented by network transports.
+   * The bytes on the wire are the same as without transfer object:
+   * the transport only avoids copying payloads into and out of its streams.
+   */
+  class tBufferTransfer
+  {
+  public:
+
+    virtual ~tBufferTransfer() {}
+
+    /*!
+     * Called when a buffer's payload is to be read from the stream (after its size was read).
+     * The transport must consume the payload's bytes from the stream.
+     * Payload is guaranteed to be contained in the stream's current buffer (as frames must be fully buffered - see ReadBuffer()).
+     *
+     * \param stream Stream to read from
+     * \param size Size of payload in bytes
+     * \return Buffer with payload - typically a view into the transport's receive buffer whose owner keeps it alive
+     */
+    virtual tRPCBuffer ReadBuffer(rrlib::serialization::tInputStream& stream, size_t size) = 0;
+
+    /*!
+     * Called when a buffer's payload is to be written to the stream
+     * (after its size was written - or as forwarded parameter bytes, see WriteOpaqueBytes()).
+     * Instead of copying the payload to the stream, the transport sends it at the current stream position
+     * (e.g. as separate iovec with writev) - keeping a copy of the buffer until it has been sent.
+     *
+     * \param stream Stream the call is serialized to
+     * \param buffer Buffer whose payload is to be sent
+     */
+    virtual void WriteBuffer(rrlib::serialization::tOutputStream& stream, const tRPCBuffer& buffer) = 0;
+  };
+
+  tWireFormat(tEncoding encoding = tEncoding::LEGACY);
+
+  /*!
+   * \return Tag of raw blocks written by this process
+   */
+  static tBlockTag GetNativeRawBlockTag()
+  {
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return cRAW_BIG_ENDIAN_BLOCK;
+#else
+    return cRAW_LITTLE_ENDIAN_BLOCK;
+#endif
+  }
+
+  /*!
+   * \return Encoding used by this object
+   */
+  tEncoding GetEncoding() const
+  {
+    return encoding;
+  }
+
+  /*!
+   * \return Shared wire format object with LEGACY encoding (stateless - may be used by any thread and connection)
+   */
+  static tWireFormat& Legacy();
+
+  /*!
+   * \param other Wire format of another connection
+   * \return True if parameters serialized for this connection can be forwarded unchanged to the other connection
+   *         (same encoding and raw block setting - assuming raw blocks are enabled symmetrically on both sides of a connection)
+   */
+  bool HasCompatibleParameterEncoding(const tWireFormat& other) const
+  {
+    return encoding == other.encoding && RawBlocksEnabled() == other.RawBlocksEnabled();
+  }
+
+  /*!
+   * \return True if trivially copyable parameters and return values are written as raw blocks
+   */
+  bool RawBlocksEnabled() const
+  {
+    return encoding == tEncoding::COMPACT && raw_blocks;
+  }
+
+  /*!
+   * Reads tRPCBuffer from stream (without copying the payload if a buffer transfer object is set)
+   * Stream must contain the complete frame that buffer is part of: size is checked against stream.Remaining(),
+   * which only covers the stream's current buffer (streams that fetch further data from a source on demand
+   * would have valid payloads rejected).
+   *
+   * \throw std::runtime_error if buffer size exceeds the remaining size of the stream
+   */
+  tRPCBuffer ReadBuffer(rrlib::serialization::tInputStream& stream) const;
+
+  /*!
+   * Reads call id from stream
+   */
+  tCallId ReadCallId(rrlib::serialization::tInputStream& stream) const;
+
+  /*!
+   * Reads RPC interface type from stream
+   * (typically called by network transport implementation - followed by reading the function index byte)
+   *
+   * \throw std::runtime_error if handle is unknown
+   */
+  rrlib::rtti::tType ReadInterfaceType(rrlib::serialization::tInputStream& stream);
+
+  /*!
+   * Reads promise flag and status of a response from stream
+   *
+   * \throw std::runtime_error if status is invalid
+   */
+  void ReadResponseStatus(rrlib::serialization::tInputStream& stream, bool& promise_response, tFutureStatus& status) const;
+
+  /*!
+   * Reads timeout (remaining time until deadline) from stream
+   */
+  rrlib::time::tDuration ReadTimeout(rrlib::serialization::tInputStream& stream) const;
+
+  /*!
+   * Reads unsigned LEB128 varint from stream
+   *
+   * \throw std::runtime_error if varint is longer than 10 bytes or does not fit into 64 bits
+   */
+  static uint64_t ReadVarint(rrlib::serialization::tInputStream& stream);
+
+  /*!
+   * Clears interface type tables (e.g. when connection is re-established)
+   */
+  void Reset();
+
+  /*!
+   * \param buffer_transfer Object that transfers tRPCBuffer payloads without copying (NULL to copy payloads to/from streams).
+   *                        Must outlive this object or be reset before being deleted.
+   */
+  void SetBufferTransfer(tBufferTransfer* buffer_transfer)
+  {
+    this->buffer_transfer = buffer_transfer;
+  }
+
+  /*!
+   * Enables writing trivially copyable parameters and return values as raw blocks (COMPACT encoding only).
+   * Must only be enabled if the peer has the same byte order and ABI - e.g. after
+   * exchanging GetNativeRawBlockTag() during connection setup. Otherwise, values are written field by field.
+   * Reading raw blocks is always possible if they stem from a peer with the same byte order.
+   *
+   * \param enabled Whether to write raw blocks
+   */
+  void SetRawBlocksEnabled(bool enabled)
+  {
+    raw_blocks = enabled;
+  }
+
+  /*!
+   * Writes tRPCBuffer to stream (without copying the payload if a buffer transfer object is set)
+   */
+  void WriteBuffer(rrlib::serialization::tOutputStream& stream, const tRPCBuffer& buffer) const;
+
+  /*!
+   * Writes call id to stream
+   */
+  void WriteCallId(rrlib::serialization::tOutputStream& stream, tCallId call_id) const;
+
+  /*!
+   * Writes RPC interface type to stream
+   * (registers type with this connection if it is written for the first time)
+   */
+  void WriteInterfaceType(rrlib::serialization::tOutputStream& stream, const rrlib::rtti::tType& type);
+
+  /*!
+   * Writes already serialized bytes to stream (e.g. forwarded parameters - without size;
+   * without copying if a buffer transfer object is set)
+   */
+  void WriteOpaqueBytes(rrlib::serialization::tOutputStream& stream, const tRPCBuffer& bytes) const;
+
+  /*!
+   * Writes promise flag and status of a response to stream
+   */
+  void WriteResponseStatus(rrlib::serialization::tOutputStream& stream, bool promise_response, tFutureStatus status) const;
+
+  /*!
+   * Writes timeout (remaining time until deadline) to stream
+   */
+  void WriteTimeout(rrlib::serialization::tOutputStream& stream, const rrlib::time::tDuration& timeout) const;
+
+  /*!
+   * Writes unsigned LEB128 varint to stream (7 bits per byte, least significant group first)
+   */
+  static void WriteVarint(rrlib::serialization::tOutputStream& stream, uint64_t value);
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Encoding used by this object */
+  tEncoding encoding;
+
+  /*! Write trivially copyable values as raw blocks? */
+  bool raw_blocks;
+
+  /*! Object that transfers tRPCBuffer payloads without copying (optional) */
+  tBufferTransfer* buffer_transfer;
+
+  /*! Handles of interface types that have been written to this connection (key is type uid) */
+  std::unordered_map<uint16_t, uint64_t> outgoing_types;
+
+  /*! Interface types that have been read from this connection (index is handle) */
+  std::vector<rrlib::rtti::tType> incoming_types;
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -48,12 +48,16 @@
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "plugins/rpc_ports/tExecutor.h"
 #include "plugins/rpc_ports/tResponseHandler.h"
+#include "plugins/rpc_ports/tResult.h"
 #include "plugins/rpc_ports/tRPCException.h"
+#include "plugins/rpc_ports/tRPCFunction.h"
 #include "plugins/rpc_ports/tRPCInterfaceType.h"
 #include "plugins/rpc_ports/internal/tRPCMessage.h"
 #include "plugins/rpc_ports/internal/tRPCPort.h"
 #include "plugins/rpc_ports/internal/tRPCRequest.h"
+#include "plugins/rpc_ports/internal/tServerCall.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -87,19 +91,28 @@ class tClientPort : public core::tPortWrapperBase
 
   /*!
    * Helper struct to extract types from function type
+   * (has no 'type' if TFunction is no member function of T - so that overloads of call methods can be resolved)
    */
   template <typename TFunction>
   struct tReturnType
-  {
-    template <typename RETURN, typename ... TArgs>
-    static RETURN ExtractReturnType(RETURN(T::*function_pointer)(TArgs...));
+  {};
 
-    template <typename RETURN, typename ... TArgs>
-    static RETURN ExtractReturnType(RETURN(T::*function_pointer)(TArgs...) const);
+  template <typename RETURN, typename ... TArgs>
+  struct tReturnType<RETURN(T::*)(TArgs...)>
+  {
+    typedef RETURN type;
+  };
 
-    typedef decltype(ExtractReturnType(MakeU<TFunction>())) type;
+  template <typename RETURN, typename ... TArgs>
+  struct tReturnType<RETURN(T::*)(TArgs...) const>
+  {
+    typedef RETURN type;
   };
 
+  template <typename TFunction, TFunction FUNCTION>
+  struct tReturnType<tRPCFunction<TFunction, FUNCTION>> : public tReturnType<TFunction>
+  {};
+
   template <typename TFunction>
   struct tMessageType
   {
@@ -109,7 +122,7 @@ class tClientPort : public core::tPortWrapperBase
     template <typename RETURN, typename ... TArgs>
     static internal::tRPCMessage<TArgs...> ExtractMessageType(RETURN(T::*function_pointer)(TArgs...) const);
 
-    typedef decltype(ExtractMessageType(MakeU<TFunction>())) type;
+    typedef decltype(ExtractMessageType(MakeU<typename internal::tRPCFunctionTraits<TFunction>::tFunctionPointer>())) type;
   };
 
   template <typename TFunction>
@@ -121,7 +134,19 @@ class tClientPort : public core::tPortWrapperBase
     template <typename RETURN, typename ... TArgs>
     static internal::tRPCRequest<RETURN, TArgs...> ExtractRequestType(RETURN(T::*function_pointer)(TArgs...) const);
 
-    typedef decltype(ExtractRequestType(MakeU<TFunction>())) type;
+    typedef decltype(ExtractRequestType(MakeU<typename internal::tRPCFunctionTraits<TFunction>::tFunctionPointer>())) type;
+  };
+
+  template <typename TFunction>
+  struct tServerCallType
+  {
+    template <typename RETURN, typename ... TArgs>
+    static internal::tServerCall<T, RETURN(T::*)(TArgs...), RETURN, TArgs...> ExtractServerCallType(RETURN(T::*function_pointer)(TArgs...));
+
+    template <typename RETURN, typename ... TArgs>
+    static internal::tServerCall<const T, RETURN(T::*)(TArgs...) const, RETURN, TArgs...> ExtractServerCallType(RETURN(T::*function_pointer)(TArgs...) const);
+
+    typedef decltype(ExtractServerCallType(MakeU<typename internal::tRPCFunctionTraits<TFunction>::tFunctionPointer>())) type;
   };
 
 //----------------------------------------------------------------------
@@ -129,6 +154,22 @@ class tClientPort : public core::tPortWrapperBase
 //----------------------------------------------------------------------
 public:
 
+  /*!
+   * While an object of this type exists, calls that the current thread sends to remote servers
+   * (via any client port) are collected and handed to the network ports in batches when the scope ends.
+   * Collected calls are also sent before the thread waits for the result of a call.
+   *
+   * Example:
+   *   {
+   *     tClientPort<tMyInterface>::tBatchScope batch;
+   *     for (int i = 0; i < 200; i++)
+   *     {
+   *       client_port.Call(&tMyInterface::SetValue, i);
+   *     }
+   *   } // calls are sent here
+   */
+  typedef internal::tRPCPort::tBatchScope tBatchScope;
+
   /*! Creates no wrapped port */
   tClientPort() {}
 
@@ -177,19 +218,12 @@ public:
       tRPCInterface* server_interface = server_port->GetCallHandler();
       if (server_interface)
       {
-        try
-        {
-          (static_cast<T*>(server_interface)->*function)(std::forward<TArgs>(args)...);
-        }
-        catch (const tRPCException& e)
-        {
-          FINROC_LOG_PRINT(DEBUG, e);
-        }
+        LocalCall(*server_port, *server_interface, function, std::forward<TArgs>(args)...);
       }
       else
       {
         typedef typename tMessageType<TFunction>::type tMessage;
-        typename internal::tCallStorage::tPointer call_storage = internal::tCallStorage::GetUnused();
+        typename internal::tCallStorage::tPointer call_storage = internal::tCallStorage::GetUnused<tMessage>();
         call_storage->Emplace<tMessage>(*call_storage, server_port->GetDataType(), tRPCInterfaceType<T>::GetFunctionID(function), std::forward<TArgs>(args)...);
         server_port->SendCall(call_storage);
       }
@@ -200,6 +234,7 @@ public:
   /*!
    * Calls specified function asynchronously
    * Result of function call is forwarded to the return handler provided.
+   * Uses default timeout (see GetTimeout()).
    *
    * \param response_handler Return handler to receive results
    * \param function Function to call
@@ -207,6 +242,21 @@ public:
    */
   template <typename TFunction, typename ... TArgs>
   void CallAsynchronous(tResponseHandler<typename tReturnType<TFunction>::type>& response_handler, TFunction function, TArgs && ... args)
+  {
+    CallAsynchronous(GetTimeout(function), response_handler, function, std::forward<TArgs>(args)...);
+  }
+
+  /*!
+   * Calls specified function asynchronously
+   * Result of function call is forwarded to the return handler provided.
+   *
+   * \param timeout Timeout for function call (response handler is notified with TIMEOUT if no result arrives before)
+   * \param response_handler Return handler to receive results
+   * \param function Function to call
+   * \param args Arguments for function call
+   */
+  template <typename TFunction, typename ... TArgs>
+  void CallAsynchronous(rrlib::time::tDuration timeout, tResponseHandler<typename tReturnType<TFunction>::type>& response_handler, TFunction function, TArgs && ... args)
   {
     typedef typename tReturnType<TFunction>::type tReturn;
     static_assert(!std::is_same<tReturn, void>::value, "Call plain Call() for functions without return value");
@@ -221,21 +271,26 @@ public:
     tRPCInterface* server_interface = server_port->GetCallHandler();
     if (server_interface)
     {
-      try
+      tFuture<tReturn> future = LocalFutureCall(*server_port, *server_interface, timeout, function, std::forward<TArgs>(args)...);
+      if (!(future.storage && future.storage->AttachResponseHandler(&response_handler)))
       {
-        response_handler.HandleResponse((static_cast<T*>(server_interface)->*function)(std::forward<TArgs>(args)...));
-      }
-      catch (const tRPCException& e)
-      {
-        response_handler.HandleException(e.GetType());
+        tResult<tReturn> result = future.TryGet(rrlib::time::tDuration::zero());
+        if (result.Ok())
+        {
+          response_handler.HandleResponse(std::move(result.GetValue()));
+        }
+        else
+        {
+          response_handler.HandleException(result.GetStatus());
+        }
       }
       return;
     }
 
     // prepare storage object
     typedef typename tRequestType<TFunction>::type tRequest;
-    typename internal::tCallStorage::tPointer call_storage = internal::tCallStorage::GetUnused();
-    tRequest& request = call_storage->Emplace<tRequest>(*call_storage, *server_port, tRPCInterfaceType<T>::GetFunctionID(function), std::chrono::seconds(5), std::forward<TArgs>(args)...);
+    typename internal::tCallStorage::tPointer call_storage = internal::tCallStorage::GetUnused<tRequest>();
+    tRequest& request = call_storage->Emplace<tRequest>(*call_storage, *server_port, tRPCInterfaceType<T>::GetFunctionID(function), timeout, std::forward<TArgs>(args)...);
 
     request.SetResponseHandler(response_handler);
     server_port->SendCall(call_storage);
@@ -246,6 +301,7 @@ public:
    * Calls specified function
    * This blocks until return value is available or timeout expires.
    * Throws a tRPCException if port is not connected, the timeout expires or parameters are invalid.
+   * Waits according to the wait policy of this port.
    *
    * \param timeout Timeout for function call
    * \param function Function to call
@@ -254,6 +310,64 @@ public:
    */
   template <typename TFunction, typename ... TArgs>
   typename tReturnType<TFunction>::type CallSynchronous(rrlib::time::tDuration timeout, TFunction function, TArgs && ... args)
+  {
+    return CallSynchronous(timeout, GetWaitPolicy(), function, std::forward<TArgs>(args)...);
+  }
+
+  /*!
+   * Calls specified function
+   * This blocks until return value is available or timeout expires.
+   * Throws a tRPCException if port is not connected, the timeout expires or parameters are invalid.
+   *
+   * \param timeout Timeout for function call
+   * \param wait_policy Policy for waiting for the result (spinning and/or blocking)
+   * \param function Function to call
+   * \param args Arguments for function call
+   * \return Result of function call
+   */
+  template <typename TFunction, typename ... TArgs>
+  typename tReturnType<TFunction>::type CallSynchronous(rrlib::time::tDuration timeout, const tWaitPolicy& wait_policy, TFunction function, TArgs && ... args)
+  {
+    tResult<typename tReturnType<TFunction>::type> result = TryCallSynchronous(timeout, wait_policy, function, std::forward<TArgs>(args)...);
+    if (!result.Ok())
+    {
+      throw tRPCException(result.GetStatus());
+    }
+    return std::move(result.GetValue());
+  }
+
+  /*!
+   * Calls specified function
+   * This blocks until return value is available or timeout expires.
+   * Does not throw exceptions if port is not connected, the timeout expires etc. - but returns result with
+   * the respective status (this is significantly cheaper if failures are frequent).
+   * Waits according to the wait policy of this port.
+   *
+   * \param timeout Timeout for function call
+   * \param function Function to call
+   * \param args Arguments for function call
+   * \return Result of function call - or status describing why call failed
+   */
+  template <typename TFunction, typename ... TArgs>
+  tResult<typename tReturnType<TFunction>::type> TryCallSynchronous(rrlib::time::tDuration timeout, TFunction function, TArgs && ... args)
+  {
+    return TryCallSynchronous(timeout, GetWaitPolicy(), function, std::forward<TArgs>(args)...);
+  }
+
+  /*!
+   * Calls specified function
+   * This blocks until return value is available or timeout expires.
+   * Does not throw exceptions if port is not connected, the timeout expires etc. - but returns result with
+   * the respective status (this is significantly cheaper if failures are frequent).
+   *
+   * \param timeout Timeout for function call
+   * \param wait_policy Policy for waiting for the result (spinning and/or blocking)
+   * \param function Function to call
+   * \param args Arguments for function call
+   * \return Result of function call - or status describing why call failed
+   */
+  template <typename TFunction, typename ... TArgs>
+  tResult<typename tReturnType<TFunction>::type> TryCallSynchronous(rrlib::time::tDuration timeout, const tWaitPolicy& wait_policy, TFunction function, TArgs && ... args)
   {
     typedef typename tReturnType<TFunction>::type tReturn;
     static_assert(!std::is_same<tReturn, void>::value, "Call plain Call() for functions without return value");
@@ -262,29 +376,30 @@ public:
     internal::tRPCPort* server_port = GetWrapped()->GetServer(true);
     if (!server_port)
     {
-      throw tRPCException(tFutureStatus::NO_CONNECTION);
+      return tResult<tReturn>(tFutureStatus::NO_CONNECTION);
     }
     tRPCInterface* server_interface = server_port->GetCallHandler();
     if (server_interface)
     {
-      return (static_cast<T*>(server_interface)->*function)(std::forward<TArgs>(args)...);
+      return LocalFutureCall(*server_port, *server_interface, timeout, function, std::forward<TArgs>(args)...).TryGet(timeout, wait_policy);
     }
 
     // prepare storage object
     typedef typename tRequestType<TFunction>::type tRequest;
-    typename internal::tCallStorage::tPointer call_storage = internal::tCallStorage::GetUnused();
+    typename internal::tCallStorage::tPointer call_storage = internal::tCallStorage::GetUnused<tRequest>();
     tRequest& request = call_storage->Emplace<tRequest>(*call_storage, *server_port, tRPCInterfaceType<T>::GetFunctionID(function), timeout, std::forward<TArgs>(args)...);
 
     // send call and wait for call returning
     tFuture<tReturn> future = request.GetFuture();
     server_port->SendCall(call_storage);
-    return future.Get(timeout);
+    return future.TryGet(timeout, wait_policy);
   }
 
   /*!
    * Calls specified function and returns a tFuture<RETURN_TYPE>.
    * This tFuture can be used to obtain and possibly wait for the
    * return value when it is needed.
+   * Uses default timeout (see GetTimeout()).
    *
    * \param function Function to call
    * \param args Arguments for function call
@@ -292,6 +407,22 @@ public:
    */
   template <typename TFunction, typename ... TArgs>
   tFuture<typename tReturnType<TFunction>::type> FutureCall(TFunction function, TArgs && ... args)
+  {
+    return FutureCall(GetTimeout(function), function, std::forward<TArgs>(args)...);
+  }
+
+  /*!
+   * Calls specified function and returns a tFuture<RETURN_TYPE>.
+   * This tFuture can be used to obtain and possibly wait for the
+   * return value when it is needed.
+   *
+   * \param timeout Timeout for function call (relevant for calls to remote servers)
+   * \param function Function to call
+   * \param args Arguments for function call
+   * \return Future to obtain return value
+   */
+  template <typename TFunction, typename ... TArgs>
+  tFuture<typename tReturnType<TFunction>::type> FutureCall(rrlib::time::tDuration timeout, TFunction function, TArgs && ... args)
   {
     typedef typename tReturnType<TFunction>::type tReturn;
     static_assert(!std::is_same<tReturn, void>::value, "Call plain Call() for functions without return value");
@@ -300,33 +431,30 @@ public:
     internal::tRPCPort* server_port = GetWrapped()->GetServer(true);
     if (!server_port)
     {
-      tPromise<tReturn> response;
-      response->SetException(tFutureStatus::NO_CONNECTION);
-      return response.GetFuture();
+      return tFuture<tReturn>(tFutureStatus::NO_CONNECTION);
     }
     tRPCInterface* server_interface = server_port->GetCallHandler();
     if (server_interface)
     {
-      tPromise<tReturn> response;
-      try
-      {
-        response->SetValue((static_cast<T*>(server_interface)->*function)(std::forward<TArgs>(args)...));
-      }
-      catch (const tRPCException& e)
-      {
-        response->SetException(e.GetType());
-      }
-      return response.GetFuture();
+      return LocalFutureCall(*server_port, *server_interface, timeout, function, std::forward<TArgs>(args)...);
     }
 
     typedef typename tRequestType<TFunction>::type tRequest;
-    typename internal::tCallStorage::tPointer call_storage = internal::tCallStorage::GetUnused();
-    tRequest& request = call_storage->Emplace<tRequest>(*call_storage, *server_port, tRPCInterfaceType<T>::GetFunctionID(function), std::chrono::seconds(5), std::forward<TArgs>(args)...);
+    typename internal::tCallStorage::tPointer call_storage = internal::tCallStorage::GetUnused<tRequest>();
+    tRequest& request = call_storage->Emplace<tRequest>(*call_storage, *server_port, tRPCInterfaceType<T>::GetFunctionID(function), timeout, std::forward<TArgs>(args)...);
     tFuture<tReturn> future = request.GetFuture();
     server_port->SendCall(call_storage);
     return future;
   }
 
+  /*!
+   * \return Default timeout for calls from this port (zero if none is set)
+   */
+  rrlib::time::tDuration GetDefaultTimeout()
+  {
+    return GetWrapped()->GetDefaultTimeout();
+  }
+
   /*!
    * \return Handle of server port that handles calls (can be used to detect when
    *         connected to a different server). 0 if not connected to a server.
@@ -337,6 +465,35 @@ public:
     return server_port ? server_port->GetHandle() : 0;
   }
 
+  /*!
+   * Determines timeout for calls that do not specify one.
+   * The first of the following that is set applies:
+   * (1) default timeout of this port (see SetDefaultTimeout())
+   * (2) default timeout registered for function in tRPCInterfaceType (see WithDefaultTimeout())
+   * (3) internal::tRPCPort::cDEFAULT_TIMEOUT
+   *
+   * \param function Function to call
+   * \return Timeout for calls to function from this port
+   */
+  template <typename TFunction>
+  rrlib::time::tDuration GetTimeout(TFunction function)
+  {
+    rrlib::time::tDuration timeout = GetWrapped()->GetDefaultTimeout();
+    if (timeout == rrlib::time::tDuration::zero())
+    {
+      timeout = tRPCInterfaceType<T>::GetDefaultTimeout(function);
+    }
+    return timeout == rrlib::time::tDuration::zero() ? internal::tRPCPort::cDEFAULT_TIMEOUT : timeout;
+  }
+
+  /*!
+   * \return Policy for waiting for results of synchronous calls from this port
+   */
+  tWaitPolicy GetWaitPolicy()
+  {
+    return GetWrapped()->GetWaitPolicy();
+  }
+
   /*!
    * \return Wrapped RPC port
    */
@@ -349,6 +506,7 @@ public:
    * Calls a function that returns a future.
    *
    * If port is not connected etc., stores exception in returned future.
+   * Uses default timeout (see GetTimeout()).
    *
    * \param function Function to call
    * \param args Arguments for function call
@@ -356,6 +514,22 @@ public:
    */
   template <typename TFunction, typename ... TArgs>
   typename tReturnType<TFunction>::type NativeFutureCall(TFunction function, TArgs && ... args)
+  {
+    return NativeFutureCall(GetTimeout(function), function, std::forward<TArgs>(args)...);
+  }
+
+  /*!
+   * Calls a function that returns a future.
+   *
+   * If port is not connected etc., stores exception in returned future.
+   *
+   * \param timeout Timeout for function call
+   * \param function Function to call
+   * \param args Arguments for function call
+   * \return Future returned by function
+   */
+  template <typename TFunction, typename ... TArgs>
+  typename tReturnType<TFunction>::type NativeFutureCall(rrlib::time::tDuration timeout, TFunction function, TArgs && ... args)
   {
     typedef typename tReturnType<TFunction>::type tReturn;
     static_assert(std::is_base_of<internal::tIsFuture, tReturn>::value, "Only suitable for functions returning a tFuture");
@@ -363,20 +537,18 @@ public:
     internal::tRPCPort* server_port = GetWrapped()->GetServer(true);
     if (!server_port)
     {
-      tPromise<typename tReturn::tValue> response;
-      response.SetException(tFutureStatus::NO_CONNECTION);
-      return response.GetFuture();
+      return tFuture<typename tReturn::tValue>(tFutureStatus::NO_CONNECTION);
     }
     tRPCInterface* server_interface = server_port->GetCallHandler();
     if (server_interface)
     {
-      return (static_cast<T*>(server_interface)->*function)(std::forward<TArgs>(args)...);
+      return LocalFutureCall(*server_port, *server_interface, timeout, function, std::forward<TArgs>(args)...);
     }
 
     // prepare storage object
     typedef typename tRequestType<TFunction>::type tRequest;
-    typename internal::tCallStorage::tPointer call_storage = internal::tCallStorage::GetUnused();
-    tRequest& request = call_storage->Emplace<tRequest>(*call_storage, *server_port, tRPCInterfaceType<T>::GetFunctionID(function), std::chrono::seconds(5), std::forward<TArgs>(args)...);
+    typename internal::tCallStorage::tPointer call_storage = internal::tCallStorage::GetUnused<tRequest>();
+    tRequest& request = call_storage->Emplace<tRequest>(*call_storage, *server_port, tRPCInterfaceType<T>::GetFunctionID(function), timeout, std::forward<TArgs>(args)...);
 
     // send call and wait for call returning
     tReturn future = request.GetFuture();
@@ -409,6 +581,28 @@ public:
     return port;
   }
 
+  /*!
+   * Sets default timeout for calls from this port that do not specify a timeout
+   * (overrides default timeouts of functions; should be set before port is used for calls)
+   *
+   * \param default_timeout Default timeout (zero to unset)
+   */
+  void SetDefaultTimeout(const rrlib::time::tDuration& default_timeout)
+  {
+    GetWrapped()->SetDefaultTimeout(default_timeout);
+  }
+
+  /*!
+   * Sets policy for waiting for results of synchronous calls from this port
+   * (e.g. spinning before blocking is beneficial with fast transports such as shared memory)
+   *
+   * \param wait_policy New wait policy
+   */
+  void SetWaitPolicy(const tWaitPolicy& wait_policy)
+  {
+    GetWrapped()->SetWaitPolicy(wait_policy);
+  }
+
   typedef core::tAbstractPortCreationInfo tConstructorParameters; // typedef required by finroc::structure::tConveniencePort
 
 //----------------------------------------------------------------------
@@ -416,6 +610,57 @@ public:
 //----------------------------------------------------------------------
 private:
 
+  /*!
+   * Calls function without return value on server in the same runtime environment.
+   * If server port has an executor, call is passed to it - otherwise, function is called directly.
+   *
+   * \param server_port Server port
+   * \param server_interface Server interface to call function on
+   * \param function Function to call
+   * \param args Arguments for function call
+   */
+  template <typename TFunction, typename ... TArgs>
+  static void LocalCall(internal::tRPCPort& server_port, tRPCInterface& server_interface, TFunction function, TArgs && ... args)
+  {
+    typedef typename tServerCallType<TFunction>::type tServerCall;
+    tExecutor* executor = server_port.GetExecutor();
+    if (executor)
+    {
+      typename internal::tCallStorage::tPointer call_storage = internal::tCallStorage::GetUnused<tServerCall>();
+      call_storage->Emplace<tServerCall>(*call_storage, server_port.GetServerGuard(), server_port.GetServerLock(), static_cast<T&>(server_interface), internal::tRPCFunctionTraits<TFunction>::GetFunctionPointer(function), std::forward<TArgs>(args)...);
+      executor->Execute(std::move(call_storage));
+      return;
+    }
+    tServerCall::Call(server_port.GetServerLock(), static_cast<T&>(server_interface), internal::tRPCFunctionTraits<TFunction>::GetFunctionPointer(function), std::forward<TArgs>(args)...);
+  }
+
+  /*!
+   * Calls function on server in the same runtime environment.
+   * If server port has an executor, call is passed to it - otherwise, function is called directly.
+   *
+   * \param server_port Server port
+   * \param server_interface Server interface to call function on
+   * \param timeout Timeout for function call (calls not executed by executor before timeout expires are dropped)
+   * \param function Function to call
+   * \param args Arguments for function call
+   * \return Future for result (ready immediately and storing result inline if function was called directly)
+   */
+  template <typename TFunction, typename ... TArgs>
+  static typename tServerCallType<TFunction>::type::tResponseFuture LocalFutureCall(internal::tRPCPort& server_port, tRPCInterface& server_interface, const rrlib::time::tDuration& timeout, TFunction function, TArgs && ... args)
+  {
+    typedef typename tServerCallType<TFunction>::type tServerCall;
+    tExecutor* executor = server_port.GetExecutor();
+    if (executor)
+    {
+      typename internal::tCallStorage::tPointer call_storage = internal::tCallStorage::GetUnused<tServerCall>();
+      tServerCall& call = call_storage->Emplace<tServerCall>(*call_storage, server_port.GetServerGuard(), server_port.GetServerLock(), static_cast<T&>(server_interface), internal::tRPCFunctionTraits<TFunction>::GetFunctionPointer(function), std::forward<TArgs>(args)...);
+      typename tServerCall::tResponseFuture future = call.GetFuture();
+      call_storage->SetDeadline(internal::tCallStorage::DeadlineFromTimeout(timeout));
+      executor->Execute(std::move(call_storage));
+      return future;
+    }
+    return tServerCall::Call(server_port.GetServerLock(), static_cast<T&>(server_interface), internal::tRPCFunctionTraits<TFunction>::GetFunctionPointer(function), std::forward<TArgs>(args)...);
+  }
 };
 
 //----------------------------------------------------------------------
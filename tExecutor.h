@@ -0,0 +1,119 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/tExecutor.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tExecutor
+ *
+ * \b tExecutor
+ *
+ * Executes calls to server ports.
+ * By default, calls to server ports are executed by the thread that invoked them
+ * (caller thread for local calls, network thread for remote calls).
+ * Server ports that are bound to an executor pass calls to their executor instead.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__rpc_ports__tExecutor_h__
+#define __plugins__rpc_ports__tExecutor_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/internal/tCallStorage.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Executes server calls
+/*!
+ * Executes calls to server ports.
+ * By default, calls to server ports are executed by the thread that invoked them
+ * (caller thread for local calls, network thread for remote calls).
+ * Server ports that are bound to an executor pass calls to their executor instead.
+ *
+ * An executor may be shared by multiple server ports.
+ * It must exist as long as any server port is bound to it.
+ */
+class tExecutor : private rrlib::util::tNoncopyable
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*! Task to execute: Call to server function stored in call storage */
+  typedef internal::tCallStorage::tPointer tTask;
+
+  virtual ~tExecutor()
+  {}
+
+  /*!
+   * Executes task - typically asynchronously in another thread.
+   * (Executor implementations call Run() when they want to execute the task)
+   *
+   * \param task Task to execute
+   */
+  virtual void Execute(tTask && task) = 0;
+
+//----------------------------------------------------------------------
+// Protected methods
+//----------------------------------------------------------------------
+protected:
+
+  /*!
+   * Runs task in current thread
+   *
+   * \param task Task to run
+   */
+  static void Run(tTask && task);
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
@@ -35,6 +35,9 @@
  * Some irrelevant functionality (reference types, shared futures) is
  * removed as it is not required in the context of RPC ports.
  *
+ * Futures that are ready on creation (e.g. from calls to local server ports)
+ * store their result inline - without any tCallStorage.
+ *
  */
 //----------------------------------------------------------------------
 #ifndef __plugins__rpc_ports__tFuture_h__
@@ -48,8 +51,11 @@
 // Internal includes with ""
 //----------------------------------------------------------------------
 #include "plugins/rpc_ports/tResponseHandler.h"
+#include "plugins/rpc_ports/tResult.h"
 #include "plugins/rpc_ports/tRPCException.h"
 #include "plugins/rpc_ports/internal/tCallStorage.h"
+#include "plugins/rpc_ports/internal/tContinuation.h"
+#include "plugins/rpc_ports/internal/tWaitGroup.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -62,11 +68,17 @@ namespace rpc_ports
 //----------------------------------------------------------------------
 // Forward declarations / typedefs / enums
 //----------------------------------------------------------------------
+template <typename T>
+class tClientPort;
+
 namespace internal
 {
 template <typename TReturn, typename ... TArgs>
 class tRPCRequest;
 
+template <typename TReturn, typename ... TArgs>
+class tForwardedRequest;
+
 template <typename TReturn>
 class tRPCResponse;
 
@@ -84,6 +96,9 @@ class tIsFuture : private rrlib::util::tNoncopyable {};
  *
  * Some irrelevant functionality (reference types, shared futures) is
  * removed as it is not required in the context of RPC ports.
+ *
+ * Futures that are ready on creation (e.g. from calls to local server ports)
+ * store their result inline - without any tCallStorage.
  */
 template <typename T>
 class tFuture : public internal::tIsFuture
@@ -96,14 +111,15 @@ public:
 
   typedef T tValue;
 
-  tFuture() : storage(), result_buffer(NULL), callback_set(false) {}
+  tFuture() : storage(), result_buffer(NULL), callback_set(false), inline_status(tFutureStatus::INVALID_FUTURE) {}
 
   /*! Move constructor */
-  tFuture(tFuture && other) : storage(), result_buffer(NULL), callback_set(false)
+  tFuture(tFuture && other) : storage(), result_buffer(NULL), callback_set(false), inline_status(tFutureStatus::INVALID_FUTURE)
   {
     std::swap(storage, other.storage);
     std::swap(result_buffer, other.result_buffer);
     std::swap(callback_set, other.callback_set);
+    MoveInlineResult(other);
   }
 
   /*! Move assignment */
@@ -112,6 +128,8 @@ public:
     std::swap(storage, other.storage);
     std::swap(result_buffer, other.result_buffer);
     std::swap(callback_set, other.callback_set);
+    ClearInlineResult();
+    MoveInlineResult(other);
     return *this;
   }
 
@@ -120,9 +138,9 @@ public:
     if (callback_set)
     {
       assert(storage);
-      rrlib::thread::tLock lock(storage->mutex);
-      storage->response_handler = NULL;
+      storage->response_handler.store(NULL);
     }
+    ClearInlineResult();
   }
 
   /*!
@@ -131,50 +149,54 @@ public:
    * If call fails, throws an tRPCException.
    *
    * \param timeout Timeout. If this expires, a tRPCException(tFutureStatus::TIMEOUT) is thrown
+   * \param wait_policy Policy for waiting if value is not available yet (spinning and/or blocking)
    * \return Value obtained from call
    */
-  T Get(const rrlib::time::tDuration& timeout = std::chrono::seconds(5))
+  T Get(const rrlib::time::tDuration& timeout = std::chrono::seconds(5), const tWaitPolicy& wait_policy = tWaitPolicy())
   {
-    if (!Valid())
+    tResult<T> result = TryGet(timeout, wait_policy);
+    if (!result.Ok())
     {
-      throw tRPCException(tFutureStatus::INVALID_FUTURE);
+      throw tRPCException(result.GetStatus());
     }
-    tFutureStatus status = (tFutureStatus)storage->future_status.load();
-    if (status == tFutureStatus::PENDING)
+    return std::move(result.GetValue());
+  }
+
+  /*!
+   * Obtains value from future - without throwing exceptions if call fails.
+   * It it is not available blocks for the specified amount of time.
+   *
+   * \param timeout Timeout. If this expires, result has status tFutureStatus::TIMEOUT
+   * \param wait_policy Policy for waiting if value is not available yet (spinning and/or blocking)
+   * \return Value obtained from call - or status describing why call failed
+   */
+  tResult<T> TryGet(const rrlib::time::tDuration& timeout = std::chrono::seconds(5), const tWaitPolicy& wait_policy = tWaitPolicy())
+  {
+    if (!storage)
     {
-      rrlib::thread::tLock lock(storage->mutex);
-      status = (tFutureStatus)storage->future_status.load();
-      if (status == tFutureStatus::PENDING)
+      if (inline_status != tFutureStatus::READY)
       {
-        if (storage->waiting)
-        {
-          RRLIB_LOG_PRINT(ERROR, "There's already a thread waiting on this object");
-          throw tRPCException(tFutureStatus::INVALID_CALL);
-        }
-        storage->waiting = true;
-        std::cv_status cv_status = storage->condition_variable.wait_for(lock.GetSimpleLock(), timeout);
-        storage->waiting = false;
-        if (cv_status == std::cv_status::timeout)
-        {
-          throw tRPCException(tFutureStatus::TIMEOUT);
-        }
-        status = (tFutureStatus)storage->future_status.load();
-        if (status == tFutureStatus::PENDING)
-        {
-          throw tRPCException(tFutureStatus::INTERNAL_ERROR);
-        }
+        return tResult<T>(inline_status);
       }
+      tResult<T> result(std::move(*InlineValue()));
+      ClearInlineResult();
+      return result;
+    }
+    tFutureStatus status = storage->GetFutureStatus();
+    if (status == tFutureStatus::PENDING)
+    {
+      status = storage->WaitForCompletion(timeout, wait_policy);
     }
 
     if (status != tFutureStatus::READY)
     {
-      throw tRPCException(status);
+      return tResult<T>(status);
     }
 
-    T result = std::move(*result_buffer);
+    tResult<T> result(std::move(*result_buffer));
     storage.reset();
     result_buffer = NULL;
-    return std::move(result);
+    return result;
   }
 
   /*!
@@ -186,7 +208,44 @@ public:
     {
       return false;
     }
-    return storage->future_status.load() != (int)tFutureStatus::PENDING;
+    return GetStatus() != tFutureStatus::PENDING;
+  }
+
+  /*!
+   * Attaches a continuation to this future.
+   * When this future receives its value, the callable is invoked with it - in the thread that
+   * provides the value (or immediately, if this future is already ready).
+   * No thread blocks while waiting.
+   * If this future receives an exception, the callable is not invoked and the returned future
+   * receives the same exception. Callables may also throw tRPCException.
+   * Callables may return a future themselves - returned futures are flattened (e.g. to chain
+   * multiple RPC calls).
+   *
+   * This future is invalid after this call.
+   *
+   * \param callable Callable to invoke with value of this future
+   * \return Future for result of callable
+   */
+  template <typename TCallable>
+  tFuture<typename internal::tContinuationResult<T, typename std::decay<TCallable>::type>::type> Then(TCallable && callable)
+  {
+    typedef internal::tContinuation<T, typename std::decay<TCallable>::type> tContinuation;
+    if ((!Valid()) || callback_set)
+    {
+      throw std::runtime_error("Cannot attach continuation");
+    }
+    if (!storage)
+    {
+      // Ready on creation: invoke immediately (does not require any storage)
+      typename std::decay<TCallable>::type callable_copy(std::forward<TCallable>(callable));
+      return tContinuation::Invoke(callable_copy, TryGet(rrlib::time::tDuration::zero()));
+    }
+
+    typename internal::tCallStorage::tPointer continuation_storage = internal::tCallStorage::GetUnused<tContinuation>();
+    tContinuation& continuation = continuation_storage->template Emplace<tContinuation>(*continuation_storage, std::move(*this), std::forward<TCallable>(callable));
+    auto result = continuation.GetFuture();
+    continuation.Start(std::move(continuation_storage));
+    return result;
   }
 
   /*!
@@ -198,18 +257,22 @@ public:
    */
   void SetCallback(tResponseHandler<T>& callback)
   {
-    if ((!storage) || callback_set)
+    if ((!Valid()) || callback_set)
     {
       throw std::runtime_error("Cannot set callback");
     }
-    storage->response_handler = &callback;
+    if (!storage)
+    {
+      return; // future already has value
+    }
+    storage->response_handler.store(&callback);
     callback_set = true;
   }
 
   /*! see std::future::valid() */
   bool Valid() const
   {
-    return storage.get();
+    return storage.get() || inline_status != tFutureStatus::INVALID_FUTURE;
   }
 
 //----------------------------------------------------------------------
@@ -220,12 +283,27 @@ private:
   template <typename TReturn, typename ... TArgs>
   friend class internal::tRPCRequest;
 
+  template <typename TReturn, typename ... TArgs>
+  friend class internal::tForwardedRequest;
+
   template <typename TReturn>
   friend class internal::tRPCResponse;
 
   template <typename TReturn>
   friend class tPromise;
 
+  template <typename TInterface>
+  friend class tClientPort;
+
+  template <typename TValue, typename TCallable>
+  friend class internal::tContinuation;
+
+  template <typename TValue>
+  friend class internal::tWaitGroupHandler;
+
+  template <typename TInterface, typename TFunction, typename TReturn, typename ... TArgs>
+  friend class internal::tServerCall;
+
 
   /*! Pointer to shared storage */
   typename internal::tCallStorage::tFuturePointer storage;
@@ -236,14 +314,216 @@ private:
   /*! True, if a callback for this future was set */
   bool callback_set;
 
+  /*!
+   * Status of futures without shared storage (futures that were ready on creation).
+   * READY if inline_value_memory contains the result. INVALID_FUTURE if there is no inline result.
+   */
+  tFutureStatus inline_status;
+
+  /*! Memory for result of futures that were ready on creation (avoids default-constructing T) */
+  typename std::aligned_storage<sizeof(T), alignof(T)>::type inline_value_memory;
+
 
   tFuture(typename internal::tCallStorage::tFuturePointer && storage, T& result_buffer) :
     storage(std::move(storage)),
     result_buffer(&result_buffer),
-    callback_set(false)
+    callback_set(false),
+    inline_status(tFutureStatus::INVALID_FUTURE)
   {}
+
+  /*!
+   * Creates future that is ready with the specified value (without any shared storage)
+   */
+  tFuture(tFutureStatus ready, T && value) :
+    storage(),
+    result_buffer(NULL),
+    callback_set(false),
+    inline_status(tFutureStatus::READY)
+  {
+    assert(ready == tFutureStatus::READY);
+    new(&inline_value_memory) T(std::move(value));
+  }
+
+  /*!
+   * Creates future that contains the specified exception (without any shared storage)
+   */
+  explicit tFuture(tFutureStatus exception_status) :
+    storage(),
+    result_buffer(NULL),
+    callback_set(false),
+    inline_status(exception_status)
+  {
+    assert(exception_status != tFutureStatus::READY && exception_status != tFutureStatus::PENDING);
+  }
+
+  /*!
+   * Destructs inline value - if there is one
+   */
+  void ClearInlineResult()
+  {
+    if (inline_status == tFutureStatus::READY)
+    {
+      InlineValue()->~T();
+    }
+    inline_status = tFutureStatus::INVALID_FUTURE;
+  }
+
+  /*!
+   * \return Status of call (also for futures without shared storage)
+   */
+  tFutureStatus GetStatus() const
+  {
+    return storage ? storage->GetFutureStatus() : inline_status;
+  }
+
+  /*!
+   * \return Pointer to inline value (only valid if inline_status is READY)
+   */
+  T* InlineValue()
+  {
+    return reinterpret_cast<T*>(&inline_value_memory);
+  }
+
+  /*!
+   * Moves inline result from other future to this (empty) future
+   */
+  void MoveInlineResult(tFuture& other)
+  {
+    assert(inline_status == tFutureStatus::INVALID_FUTURE);
+    if (other.inline_status == tFutureStatus::READY)
+    {
+      new(&inline_value_memory) T(std::move(*other.InlineValue()));
+    }
+    inline_status = other.inline_status;
+    other.ClearInlineResult();
+  }
 };
 
+//----------------------------------------------------------------------
+// Function declarations
+//----------------------------------------------------------------------
+namespace internal
+{
+
+inline bool WaitForFutures(tWaitGroup& group, const rrlib::time::tDuration& timeout)
+{
+  return group.Wait(timeout);
+}
+
+template <typename TFirst, typename ... TRest>
+bool WaitForFutures(tWaitGroup& group, const rrlib::time::tDuration& timeout, tFuture<TFirst>& first, tFuture<TRest>& ... rest)
+{
+  tWaitGroupHandler<TFirst> handler; // detaches from future when going out of scope
+  handler.Attach(group, first);
+  return WaitForFutures(group, timeout, rest...);
+}
+
+template <typename TContainer>
+bool WaitForFutureContainer(tWaitGroup& group, const rrlib::time::tDuration& timeout, TContainer& futures)
+{
+  typedef tWaitGroupHandler<typename TContainer::value_type::tValue> tHandler;
+  std::unique_ptr<tHandler[]> handlers(new tHandler[futures.size()]); // detach from futures when deleted
+  size_t index = 0;
+  for (auto it = futures.begin(); it != futures.end(); ++it, ++index)
+  {
+    handlers[index].Attach(group, *it);
+  }
+  return group.Wait(timeout);
+}
+
+inline int GetFirstCompleted(int index)
+{
+  return -1;
+}
+
+template <typename TFirst, typename ... TRest>
+int GetFirstCompleted(int index, tFuture<TFirst>& first, tFuture<TRest>& ... rest)
+{
+  return ((!first.Valid()) || first.Ready()) ? index : GetFirstCompleted(index + 1, rest...);
+}
+
+}
+
+/*!
+ * Blocks until all specified futures have completed (or timeout expires).
+ * The calling thread is woken up only once - when the last future completes.
+ * Results can be obtained from the futures afterwards without waiting.
+ * Futures with callbacks are not supported.
+ *
+ * \param timeout Maximum time to wait
+ * \param futures Futures to wait for
+ * \return True if all futures have completed. False if timeout expired.
+ */
+template <typename ... T>
+bool WhenAll(const rrlib::time::tDuration& timeout, tFuture<T>& ... futures)
+{
+  internal::tWaitGroup group(sizeof...(T));
+  return internal::WaitForFutures(group, timeout, futures...);
+}
+
+/*!
+ * Blocks until all futures in the specified container have completed (or timeout expires).
+ * The calling thread is woken up only once - when the last future completes.
+ * Results can be obtained from the futures afterwards without waiting.
+ * Futures with callbacks are not supported.
+ *
+ * \param timeout Maximum time to wait
+ * \param futures Container with futures to wait for (e.g. std::vector<tFuture<T>>)
+ * \return True if all futures have completed. False if timeout expired.
+ */
+template <typename TContainer>
+typename std::enable_if < !std::is_base_of<internal::tIsFuture, TContainer>::value, bool >::type WhenAll(const rrlib::time::tDuration& timeout, TContainer& futures)
+{
+  internal::tWaitGroup group(futures.size());
+  return internal::WaitForFutureContainer(group, timeout, futures);
+}
+
+/*!
+ * Blocks until any of the specified futures has completed (or timeout expires).
+ * Futures with callbacks are not supported.
+ *
+ * \param timeout Maximum time to wait
+ * \param futures Futures to wait for
+ * \return Index of (first) completed future. -1 if timeout expired.
+ */
+template <typename ... T>
+int WhenAny(const rrlib::time::tDuration& timeout, tFuture<T>& ... futures)
+{
+  internal::tWaitGroup group(sizeof...(T) ? 1 : 0);
+  if (!internal::WaitForFutures(group, timeout, futures...))
+  {
+    return -1;
+  }
+  return internal::GetFirstCompleted(0, futures...);
+}
+
+/*!
+ * Blocks until any of the futures in the specified container has completed (or timeout expires).
+ * Futures with callbacks are not supported.
+ *
+ * \param timeout Maximum time to wait
+ * \param futures Container with futures to wait for (e.g. std::vector<tFuture<T>>)
+ * \return Index of (first) completed future. -1 if timeout expired.
+ */
+template <typename TContainer>
+typename std::enable_if < !std::is_base_of<internal::tIsFuture, TContainer>::value, int >::type WhenAny(const rrlib::time::tDuration& timeout, TContainer& futures)
+{
+  internal::tWaitGroup group(futures.size() ? 1 : 0);
+  if (!internal::WaitForFutureContainer(group, timeout, futures))
+  {
+    return -1;
+  }
+  int index = 0;
+  for (auto it = futures.begin(); it != futures.end(); ++it, ++index)
+  {
+    if ((!it->Valid()) || it->Ready())
+    {
+      return index;
+    }
+  }
+  return -1;
+}
+
 //----------------------------------------------------------------------
 // End of namespace declaration
 //----------------------------------------------------------------------
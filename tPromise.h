@@ -107,7 +107,7 @@ public:
   typedef T tValue;
 
   tPromise() :
-    storage(internal::tCallStorage::GetUnused()),
+    storage(internal::tCallStorage::GetUnused<tStorageContents>()),
     result_buffer(&(storage->Emplace<tStorageContents>(*storage)).result_buffer)
   {
     storage->future_status.store(static_cast<int>(tFutureStatus::PENDING));
@@ -158,21 +158,18 @@ public:
    */
   void SetValue(T && value)
   {
-    tFutureStatus current = (tFutureStatus)storage->future_status.load();
+    tFutureStatus current = storage->GetFutureStatus();
     if (current != tFutureStatus::PENDING)
     {
       FINROC_LOG_PRINT(WARNING, "Call already has status ", make_builder::GetEnumString(current), ". Ignoring.");
       return;
     }
 
-    rrlib::thread::tLock lock(storage->mutex);
     *result_buffer = std::move(value);
-    storage->future_status.store((int)tFutureStatus::READY);
-    storage->condition_variable.notify_one();
-    if (storage->response_handler)
+    internal::tAbstractResponseHandler* handler = storage->Complete(tFutureStatus::READY);
+    if (handler)
     {
-      lock.Unlock();
-      static_cast<tResponseHandler<T>*>(storage->response_handler)->HandleResponse(std::move(*result_buffer));
+      static_cast<tResponseHandler<T>*>(handler)->HandleResponse(std::move(*result_buffer));
     }
   }
   void SetValue(T& value)
@@ -181,21 +178,18 @@ public:
   }
   void SetValue(const T& value)
   {
-    tFutureStatus current = (tFutureStatus)storage->future_status.load();
+    tFutureStatus current = storage->GetFutureStatus();
     if (current != tFutureStatus::PENDING)
     {
       FINROC_LOG_PRINT(WARNING, "Call already has status ", make_builder::GetEnumString(current), ". Ignoring.");
       return;
     }
 
-    rrlib::thread::tLock lock(storage->mutex);
     *result_buffer = value;
-    storage->future_status.store((int)tFutureStatus::READY);
-    storage->condition_variable.notify_one();
-    if (storage->response_handler)
+    internal::tAbstractResponseHandler* handler = storage->Complete(tFutureStatus::READY);
+    if (handler)
     {
-      lock.Unlock();
-      static_cast<tResponseHandler<T>*>(storage->response_handler)->HandleResponse(std::move(*result_buffer));
+      static_cast<tResponseHandler<T>*>(handler)->HandleResponse(std::move(*result_buffer));
     }
   }
 
@@ -235,18 +229,17 @@ private:
       rpc_interface_type()
     {}
 
-    virtual void Serialize(rrlib::serialization::tOutputStream& stream) override
+    virtual void Serialize(rrlib::serialization::tOutputStream& stream, internal::tWireFormat& wire_format) override
     {
       // Deserialized by network transport implementation
-      stream << rpc_interface_type;
+      wire_format.WriteInterfaceType(stream, rpc_interface_type);
       stream << function_index;
-      stream << remote_promise_call_id;
+      wire_format.WriteCallId(stream, remote_promise_call_id);
 
       // Deserialized by this class
-      stream << true; // promise_response
-      tFutureStatus status = (tFutureStatus)storage.future_status.load();
+      tFutureStatus status = storage.GetFutureStatus();
       assert(status == tFutureStatus::READY && "only ready responses should be serialized");
-      stream << status;
+      wire_format.WriteResponseStatus(stream, true, status);
       stream << result_buffer;
     }
   };
@@ -0,0 +1,109 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/tRPCBuffer.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/tRPCBuffer.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/internal/tWireFormat.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+tRPCBuffer::tRPCBuffer() :
+  owner(),
+  data(NULL),
+  size(0)
+{}
+
+tRPCBuffer::tRPCBuffer(std::vector<uint8_t> && data) :
+  owner(),
+  data(NULL),
+  size(data.size())
+{
+  std::shared_ptr<std::vector<uint8_t>> vector = std::make_shared<std::vector<uint8_t>>(std::move(data));
+  this->data = vector->data();
+  owner = std::move(vector);
+}
+
+tRPCBuffer::tRPCBuffer(const void* data, size_t size, std::shared_ptr<const void> owner) :
+  owner(std::move(owner)),
+  data(static_cast<const uint8_t*>(data)),
+  size(size)
+{}
+
+rrlib::serialization::tOutputStream& operator << (rrlib::serialization::tOutputStream& stream, const tRPCBuffer& buffer)
+{
+  internal::tWireFormat::Legacy().WriteBuffer(stream, buffer);
+  return stream;
+}
+
+rrlib::serialization::tInputStream& operator >> (rrlib::serialization::tInputStream& stream, tRPCBuffer& buffer)
+{
+  buffer = internal::tWireFormat::Legacy().ReadBuffer(stream);
+  return stream;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
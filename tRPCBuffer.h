@@ -0,0 +1,192 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/tRPCBuffer.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tRPCBuffer
+ *
+ * \b tRPCBuffer
+ *
+ * Immutable block of bytes for large RPC arguments and return values
+ * (e.g. images, point clouds, map tiles).
+ * Copying a buffer only copies a reference - and network transports
+ * may send and receive the payload without copying it.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__rpc_ports__tRPCBuffer_h__
+#define __plugins__rpc_ports__tRPCBuffer_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/serialization/serialization.h"
+#include <sys/uio.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Buffer argument for RPC calls
+/*!
+ * Immutable block of bytes for large RPC arguments and return values
+ * (e.g. images, point clouds, map tiles).
+ *
+ * A buffer is a view on memory that is kept alive by a shared owner.
+ * Copying a buffer only copies this reference - so buffers can be passed
+ * by value through ports, futures and call queues without copying the payload.
+ * The memory stays valid as long as any buffer (or other holder of the owner) refers to it.
+ *
+ * When sent over the network, transports that register a tWireFormat::tBufferTransfer
+ * can send the payload directly from its memory (e.g. as a separate iovec with writev)
+ * and hand received payloads to servers as views into their receive buffer.
+ * Otherwise, the payload is copied into and out of the stream like any other value.
+ */
+class tRPCBuffer
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * Creates empty buffer
+   */
+  tRPCBuffer();
+
+  /*!
+   * Creates buffer that takes ownership of the specified vector (without copying its contents)
+   */
+  tRPCBuffer(std::vector<uint8_t> && data);
+
+  /*!
+   * Creates buffer that refers to existing memory
+   *
+   * \param data Pointer to first byte
+   * \param size Size of payload in bytes
+   * \param owner Object that keeps memory alive (e.g. shared pointer to image or receive buffer)
+   */
+  tRPCBuffer(const void* data, size_t size, std::shared_ptr<const void> owner);
+
+  /*!
+   * \return Pointer to first byte of payload
+   */
+  const uint8_t* Data() const
+  {
+    return data;
+  }
+
+  /*!
+   * \return True if buffer has no payload
+   */
+  bool Empty() const
+  {
+    return size == 0;
+  }
+
+  /*!
+   * \return Payload as I/O vector (e.g. for writev)
+   */
+  iovec GetIOVector() const
+  {
+    iovec result;
+    result.iov_base = const_cast<uint8_t*>(data);
+    result.iov_len = size;
+    return result;
+  }
+
+  /*!
+   * \return Object that keeps payload alive
+   */
+  const std::shared_ptr<const void>& GetOwner() const
+  {
+    return owner;
+  }
+
+  /*!
+   * \return Size of payload in bytes
+   */
+  size_t Size() const
+  {
+    return size;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Object that keeps payload alive */
+  std::shared_ptr<const void> owner;
+
+  /*! Pointer to first byte of payload */
+  const uint8_t* data;
+
+  /*! Size of payload in bytes */
+  size_t size;
+};
+
+//----------------------------------------------------------------------
+// Function declarations
+//----------------------------------------------------------------------
+
+/*!
+ * Serializes buffer with copy of its payload (in legacy wire format - see tWireFormat::WriteBuffer)
+ */
+rrlib::serialization::tOutputStream& operator << (rrlib::serialization::tOutputStream& stream, const tRPCBuffer& buffer);
+
+/*!
+ * Deserializes buffer into newly allocated memory (in legacy wire format - see tWireFormat::ReadBuffer)
+ */
+rrlib::serialization::tInputStream& operator >> (rrlib::serialization::tInputStream& stream, tRPCBuffer& buffer);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
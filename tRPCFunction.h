@@ -0,0 +1,173 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/tRPCFunction.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tRPCFunction
+ *
+ * \b tRPCFunction
+ *
+ * Identifies a function of an RPC interface at compile time
+ * (function pointer is a template parameter).
+ * Can be used instead of plain function pointers for registering
+ * functions in tRPCInterfaceType and for calls via tClientPort.
+ * Function ids of such functions are resolved only once - instead of
+ * looking them up on every call.
+ *
+ * Example:
+ *   client_port.CallSynchronous(timeout, FINROC_RPC_FUNCTION(&tMyInterface::Function), 4);
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__rpc_ports__tRPCFunction_h__
+#define __plugins__rpc_ports__tRPCFunction_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/time/time.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+/*!
+ * Creates tRPCFunction object for the specified (non-overloaded) member function
+ */
+#define FINROC_RPC_FUNCTION(function) finroc::rpc_ports::tRPCFunction<decltype(function), function>()
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Compile-time RPC function
+/*!
+ * Identifies a function of an RPC interface at compile time
+ * (function pointer is a template parameter).
+ * Can be used instead of plain function pointers for registering
+ * functions in tRPCInterfaceType and for calls via tClientPort.
+ * Function ids of such functions are resolved only once - instead of
+ * looking them up on every call.
+ *
+ * \tparam TFunction Type of member function pointer
+ * \tparam FUNCTION Member function pointer
+ */
+template <typename TFunction, TFunction FUNCTION>
+struct tRPCFunction
+{
+  typedef TFunction tFunctionPointer;
+
+  /*!
+   * \return Member function pointer
+   */
+  static constexpr TFunction Get()
+  {
+    return FUNCTION;
+  }
+};
+
+/*!
+ * Function of an RPC interface together with a default timeout for calls to it.
+ * Can be passed to the constructor of tRPCInterfaceType instead of the plain function
+ * (see WithDefaultTimeout()).
+ *
+ * \tparam TFunction Type of member function pointer (or tRPCFunction)
+ */
+template <typename TFunction>
+struct tRPCFunctionWithTimeout
+{
+  /*! Function */
+  TFunction function;
+
+  /*! Default timeout for calls to function */
+  rrlib::time::tDuration default_timeout;
+};
+
+/*!
+ * Attaches default timeout to function when registering it in tRPCInterfaceType.
+ * The default timeout applies to calls that do not specify a timeout - unless the client port has a default timeout.
+ *
+ * Example:
+ *   tRPCInterfaceType<tMyInterface> cTYPE("MyInterface", &tMyInterface::Function1, WithDefaultTimeout(&tMyInterface::Function2, std::chrono::milliseconds(50)));
+ *
+ * \param function Function
+ * \param default_timeout Default timeout for calls to function
+ */
+template <typename TFunction>
+tRPCFunctionWithTimeout<TFunction> WithDefaultTimeout(TFunction function, const rrlib::time::tDuration& default_timeout)
+{
+  tRPCFunctionWithTimeout<TFunction> result = { function, default_timeout };
+  return result;
+}
+
+namespace internal
+{
+
+/*!
+ * Type traits to handle plain function pointers and tRPCFunction objects uniformly
+ */
+template <typename TFunction>
+struct tRPCFunctionTraits
+{
+  typedef TFunction tFunctionPointer;
+
+  static TFunction GetFunctionPointer(TFunction function)
+  {
+    return function;
+  }
+};
+
+template <typename TFunction, TFunction FUNCTION>
+struct tRPCFunctionTraits<tRPCFunction<TFunction, FUNCTION>>
+{
+  typedef TFunction tFunctionPointer;
+
+  static constexpr TFunction GetFunctionPointer(tRPCFunction<TFunction, FUNCTION> function)
+  {
+    return FUNCTION;
+  }
+};
+
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
@@ -46,6 +46,8 @@
 // Internal includes with ""
 //----------------------------------------------------------------------
 #include "plugins/rpc_ports/tClientPort.h"
+#include "plugins/rpc_ports/tRPCFunction.h"
+#include "plugins/rpc_ports/internal/tForwardedRequest.h"
 #include "plugins/rpc_ports/internal/tRPCInterfaceTypeInfo.h"
 #include "plugins/rpc_ports/internal/tRPCMessage.h"
 #include "plugins/rpc_ports/internal/tRPCRequest.h"
@@ -116,19 +118,17 @@ public:
   template <typename TFunction>
   static TFunction GetFunction(uint8_t function_id)
   {
-    std::vector<std::pair<TFunction, uint8_t>>& lookup = GetFunctionIDLookup<TFunction>();
-    for (auto it = lookup.begin(); it != lookup.end(); ++it)
+    std::vector<TFunction>& table = GetFunctionTable<TFunction>();
+    if (function_id < table.size() && table[function_id])
     {
-      if (it->second == function_id)
-      {
-        return it->first;
-      }
+      return table[function_id];
     }
     throw std::runtime_error("Function lookup failed: no such function");
   }
 
   /*!
    * Looks up function id for specified function
+   * (for frequent calls, tRPCFunction objects should be preferred, as their id is only looked up once)
    *
    * \param function Function whose id is to be looked up
    * \return Function id in this RPC interface type
@@ -136,17 +136,44 @@ public:
   template <typename TFunction>
   static uint8_t GetFunctionID(TFunction function)
   {
-    std::vector<std::pair<TFunction, uint8_t>>& lookup = GetFunctionIDLookup<TFunction>();
-    for (auto it = lookup.begin(); it != lookup.end(); ++it)
+    std::vector<TFunction>& table = GetFunctionTable<TFunction>();
+    for (size_t i = 0; function && i < table.size(); i++)
     {
-      if (it->first == function)
+      if (table[i] == function)
       {
-        return it->second;
+        return static_cast<uint8_t>(i);
       }
     }
     throw std::runtime_error("Function is not part of tRPCInterfaceType<T>");
   }
 
+  /*!
+   * \param function Function whose id is to be looked up
+   * \return Function id in this RPC interface type (looked up only once)
+   */
+  template <typename TFunction, TFunction FUNCTION>
+  static uint8_t GetFunctionID(tRPCFunction<TFunction, FUNCTION> function)
+  {
+    static const uint8_t cFUNCTION_ID = GetFunctionID(FUNCTION);
+    return cFUNCTION_ID;
+  }
+
+  /*!
+   * \param function Function
+   * \return Default timeout that was registered for specified function (zero if none was registered)
+   */
+  template <typename TFunction>
+  static rrlib::time::tDuration GetDefaultTimeout(TFunction function)
+  {
+    std::vector<rrlib::time::tDuration>& table = GetDefaultTimeoutTable();
+    if (table.empty())
+    {
+      return rrlib::time::tDuration::zero();
+    }
+    uint8_t function_id = GetFunctionID(function);
+    return function_id < table.size() ? table[function_id] : rrlib::time::tDuration::zero();
+  }
+
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
@@ -168,14 +195,22 @@ private:
   };
 
   /*!
-   * \return Function ids for specified function type.
-   * List contains all registered functions of this type - together with their id
+   * \return Table with all registered functions of specified function type (index is function id - other entries are NULL)
    */
   template <typename TFunction>
-  static std::vector<std::pair<TFunction, uint8_t>>& GetFunctionIDLookup()
+  static std::vector<TFunction>& GetFunctionTable()
   {
-    static std::vector<std::pair<TFunction, uint8_t>> lookup;
-    return lookup;
+    static std::vector<TFunction> table;
+    return table;
+  }
+
+  /*!
+   * \return Table with default timeouts of functions (index is function id - zero if no timeout was registered; empty if no function has a default timeout)
+   */
+  static std::vector<rrlib::time::tDuration>& GetDefaultTimeoutTable()
+  {
+    static std::vector<rrlib::time::tDuration> table;
+    return table;
   }
 
   static tTypeInfo* GetTypeInfo(const std::string& name = "")
@@ -189,19 +224,37 @@ private:
   template <typename TFunction, typename ... TFunctions>
   void RegisterFunctions(internal::tRPCInterfaceTypeInfo& type_info, TFunction function, TFunctions ... functions)
   {
-    RegisterFunction<TFunction>(type_info, function);
+    RegisterFunction(type_info, function);
     RegisterFunctions(type_info, functions...);
   }
 
+  template <typename TFunction, TFunction FUNCTION>
+  void RegisterFunction(internal::tRPCInterfaceTypeInfo& type_info, tRPCFunction<TFunction, FUNCTION> function)
+  {
+    RegisterFunction<TFunction>(type_info, FUNCTION);
+  }
+
+  template <typename TFunction>
+  void RegisterFunction(internal::tRPCInterfaceTypeInfo& type_info, tRPCFunctionWithTimeout<TFunction> function)
+  {
+    std::vector<rrlib::time::tDuration>& table = GetDefaultTimeoutTable();
+    table.resize(type_info.methods.size() + 1, rrlib::time::tDuration::zero());
+    table.back() = function.default_timeout;
+    RegisterFunction(type_info, function.function);
+  }
+
   template <typename TFunction>
   void RegisterFunction(internal::tRPCInterfaceTypeInfo& type_info, TFunction function)
   {
-    GetFunctionIDLookup<TFunction>().push_back(std::pair<TFunction, uint8_t>(function, static_cast<uint8_t>(type_info.methods.size())));
+    std::vector<TFunction>& table = GetFunctionTable<TFunction>();
+    table.resize(type_info.methods.size() + 1, nullptr);
+    table.back() = function;
     tEntry entry =
     {
       GetDeserializeMessageFunction(function),
       GetDeserializeRequestFunction(function),
-      GetDeserializeResponseFunction(function)
+      GetDeserializeResponseFunction(function),
+      GetForwardRequestFunction(function)
     };
     type_info.methods.emplace_back(entry);
   }
@@ -209,25 +262,38 @@ private:
   template <typename TReturn, typename ... TArgs>
   internal::tDeserializeMessage GetDeserializeMessageFunction(TReturn(T::*function_pointer)(TArgs...))
   {
-    return &internal::tRPCMessage<TArgs...>::template DeserializeAndExecuteCallImplementation<TReturn, T>;
+    return &internal::tRPCMessage<TArgs...>::template DeserializeAndExecuteCallImplementation<T, decltype(function_pointer)>;
   }
   template <typename TReturn, typename ... TArgs>
   internal::tDeserializeMessage GetDeserializeMessageFunction(TReturn(T::*function_pointer)(TArgs...) const)
   {
-    return &internal::tRPCMessage<TArgs...>::template DeserializeAndExecuteCallImplementation<TReturn, T>;
+    return &internal::tRPCMessage<TArgs...>::template DeserializeAndExecuteCallImplementation<T, decltype(function_pointer)>;
   }
 
   template <typename TReturn, typename ... TArgs>
   internal::tDeserializeRequest GetDeserializeRequestFunction(TReturn(T::*function_pointer)(TArgs...))
   {
     typedef typename std::conditional<std::is_same<TReturn, void>::value, internal::tNoRPCRequest, internal::tRPCRequest<TReturn, TArgs...>>::type tRequest;
-    return &tRequest::template DeserializeAndExecuteCallImplementation<T>;
+    return &tRequest::template DeserializeAndExecuteCallImplementation<T, decltype(function_pointer)>;
   }
   template <typename TReturn, typename ... TArgs>
   internal::tDeserializeRequest GetDeserializeRequestFunction(TReturn(T::*function_pointer)(TArgs...) const)
   {
     typedef typename std::conditional<std::is_same<TReturn, void>::value, internal::tNoRPCRequest, internal::tRPCRequest<TReturn, TArgs...>>::type tRequest;
-    return &tRequest::template DeserializeAndExecuteCallImplementation<T>;
+    return &tRequest::template DeserializeAndExecuteCallImplementation<T, decltype(function_pointer)>;
+  }
+
+  template <typename TReturn, typename ... TArgs>
+  internal::tForwardRequest GetForwardRequestFunction(TReturn(T::*function_pointer)(TArgs...))
+  {
+    typedef typename std::conditional<std::is_same<TReturn, void>::value, internal::tNoForwardedRequest, internal::tForwardedRequest<TReturn, TArgs...>>::type tRequest;
+    return &tRequest::ForwardCallImplementation;
+  }
+  template <typename TReturn, typename ... TArgs>
+  internal::tForwardRequest GetForwardRequestFunction(TReturn(T::*function_pointer)(TArgs...) const)
+  {
+    typedef typename std::conditional<std::is_same<TReturn, void>::value, internal::tNoForwardedRequest, internal::tForwardedRequest<TReturn, TArgs...>>::type tRequest;
+    return &tRequest::ForwardCallImplementation;
   }
 
   template <typename TReturn, typename ... TArgs>
@@ -0,0 +1,248 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/tResult.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tResult
+ *
+ * \b tResult
+ *
+ * Result of an RPC call: either a value or the status that describes why
+ * the call failed.
+ * Returned by the non-throwing variants of calls (e.g. tFuture::TryGet()
+ * and tClientPort::TryCallSynchronous()). Failures such as timeouts are
+ * reported without throwing (and unwinding) an exception.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__rpc_ports__tResult_h__
+#define __plugins__rpc_ports__tResult_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <type_traits>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/tRPCException.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Result of RPC call
+/*!
+ * Result of an RPC call: either a value or the status that describes why
+ * the call failed.
+ * Returned by the non-throwing variants of calls (e.g. tFuture::TryGet()
+ * and tClientPort::TryCallSynchronous()). Failures such as timeouts are
+ * reported without throwing (and unwinding) an exception.
+ *
+ * \tparam T Type of value
+ */
+template <typename T>
+class tResult
+{
+  static_assert(!std::is_same<T, tFutureStatus>::value, "tFutureStatus is not supported as value type");
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef T tValue;
+
+  /*!
+   * Creates result containing a value
+   */
+  tResult(T && value) :
+    status(tFutureStatus::READY)
+  {
+    new(&value_memory) T(std::move(value));
+  }
+  tResult(const T& value) :
+    status(tFutureStatus::READY)
+  {
+    new(&value_memory) T(value);
+  }
+
+  /*!
+   * Creates result of failed call
+   *
+   * \param status Status describing failure (must not be READY or PENDING)
+   */
+  tResult(tFutureStatus status) :
+    status(status)
+  {
+    assert(status != tFutureStatus::READY && status != tFutureStatus::PENDING);
+  }
+
+  tResult(tResult && other) :
+    status(other.status)
+  {
+    if (Ok())
+    {
+      new(&value_memory) T(std::move(*other.ValuePointer()));
+    }
+  }
+
+  tResult(const tResult& other) :
+    status(other.status)
+  {
+    if (Ok())
+    {
+      new(&value_memory) T(*other.ValuePointer());
+    }
+  }
+
+  tResult& operator=(tResult && other)
+  {
+    if (this != &other)
+    {
+      Clear();
+      status = other.status;
+      if (Ok())
+      {
+        new(&value_memory) T(std::move(*other.ValuePointer()));
+      }
+    }
+    return *this;
+  }
+
+  tResult& operator=(const tResult& other)
+  {
+    if (this != &other)
+    {
+      Clear();
+      status = other.status;
+      if (Ok())
+      {
+        new(&value_memory) T(*other.ValuePointer());
+      }
+    }
+    return *this;
+  }
+
+  ~tResult()
+  {
+    Clear();
+  }
+
+  /*!
+   * \return READY if result contains a value - otherwise status describing why call failed
+   */
+  tFutureStatus GetStatus() const
+  {
+    return status;
+  }
+
+  /*!
+   * \return Value. Throws tRPCException if result contains no value.
+   */
+  T& GetValue()
+  {
+    if (!Ok())
+    {
+      throw tRPCException(status);
+    }
+    return *ValuePointer();
+  }
+  const T& GetValue() const
+  {
+    if (!Ok())
+    {
+      throw tRPCException(status);
+    }
+    return *ValuePointer();
+  }
+
+  /*!
+   * \return Does result contain a value?
+   */
+  bool Ok() const
+  {
+    return status == tFutureStatus::READY;
+  }
+
+  explicit operator bool() const
+  {
+    return Ok();
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! READY if value_memory contains a value - otherwise status describing why call failed */
+  tFutureStatus status;
+
+  /*! Memory for value (avoids default-constructing T for failed calls) */
+  typename std::aligned_storage<sizeof(T), alignof(T)>::type value_memory;
+
+
+  /*!
+   * Destructs value - if there is one
+   */
+  void Clear()
+  {
+    if (Ok())
+    {
+      ValuePointer()->~T();
+      status = tFutureStatus::INVALID_FUTURE;
+    }
+  }
+
+  T* ValuePointer()
+  {
+    return reinterpret_cast<T*>(&value_memory);
+  }
+  const T* ValuePointer() const
+  {
+    return reinterpret_cast<const T*>(&value_memory);
+  }
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
@@ -0,0 +1,201 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/tSerialExecutor.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/tSerialExecutor.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/thread/tThread.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/internal/tFutex.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+/*! Maximum time dispatch thread blocks before checking whether it is to stop */
+static const rrlib::time::tDuration cMAX_DISPATCH_WAIT = std::chrono::seconds(1);
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+namespace
+{
+
+/*! Executor whose calls the current thread is processing (NULL if none) */
+thread_local tSerialExecutor* current_executor = NULL;
+
+/*! Sets current_executor while processing calls */
+struct tCurrentExecutorScope
+{
+  tCurrentExecutorScope(tSerialExecutor* executor) : previous(current_executor)
+  {
+    current_executor = executor;
+  }
+
+  ~tCurrentExecutorScope()
+  {
+    current_executor = previous;
+  }
+
+  tSerialExecutor* previous;
+};
+
+}
+
+class tSerialExecutor::tDispatchThread : public rrlib::thread::tThread
+{
+public:
+  tDispatchThread(tSerialExecutor& executor) :
+    rrlib::thread::tThread("RPC Serial Executor"),
+    executor(executor)
+  {}
+
+  virtual void Run() override
+  {
+    executor.Dispatch();
+  }
+
+private:
+
+  /*! Executor whose calls this thread dispatches */
+  tSerialExecutor& executor;
+};
+
+tSerialExecutor::tSerialExecutor(bool own_thread) :
+  mailbox(),
+  wake_up_counter(0),
+  dispatcher_sleeping(false),
+  stop(false),
+  batch(),
+  dispatch_thread()
+{
+  if (own_thread)
+  {
+    dispatch_thread = std::static_pointer_cast<tDispatchThread>((new tDispatchThread(*this))->GetSharedPtr());
+    dispatch_thread->Start();
+  }
+}
+
+tSerialExecutor::~tSerialExecutor()
+{
+  if (dispatch_thread)
+  {
+    stop.store(true);
+    wake_up_counter.fetch_add(1);
+    internal::tFutex::Wake(wake_up_counter);
+    dispatch_thread->Join();
+  }
+}
+
+void tSerialExecutor::Dispatch()
+{
+  tCurrentExecutorScope scope(this);
+  while (!stop.load())
+  {
+    if (mailbox.TakeAll(batch) == 0)
+    {
+      // Announce sleeping before checking mailbox again (Execute() pushes call before checking flag - both seq_cst)
+      int counter = wake_up_counter.load();
+      dispatcher_sleeping.store(true);
+      if (mailbox.Empty())
+      {
+        internal::tFutex::Wait(wake_up_counter, counter, cMAX_DISPATCH_WAIT);
+      }
+      dispatcher_sleeping.store(false);
+      continue;
+    }
+    for (tTask & task : batch)
+    {
+      Run(std::move(task));
+    }
+    batch.clear();
+  }
+}
+
+void tSerialExecutor::Execute(tTask && task)
+{
+  if (current_executor == this)
+  {
+    // Call from a server function that this executor is currently executing
+    Run(std::move(task));
+    return;
+  }
+  // Dispatch thread only needs to be woken up if it sleeps - and mailbox was empty (otherwise, whoever added the first call wakes it up)
+  if (mailbox.Push(std::move(task)) && dispatch_thread && dispatcher_sleeping.load())
+  {
+    wake_up_counter.fetch_add(1);
+    internal::tFutex::Wake(wake_up_counter);
+  }
+}
+
+size_t tSerialExecutor::ProcessCalls()
+{
+  assert((!dispatch_thread) && "Executor has its own dispatch thread");
+  tCurrentExecutorScope scope(this);
+  size_t count = mailbox.TakeAll(batch);
+  for (tTask & task : batch)
+  {
+    Run(std::move(task));
+  }
+  batch.clear();
+  return count;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -0,0 +1,151 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/tSerialExecutor.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tSerialExecutor
+ *
+ * \b tSerialExecutor
+ *
+ * Executor that executes all calls one after the other in a single thread
+ * ("single-threaded server" or actor-style dispatch).
+ * Server functions of ports bound to this executor are never called concurrently -
+ * so they need not be thread-safe and require no locking.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__rpc_ports__tSerialExecutor_h__
+#define __plugins__rpc_ports__tSerialExecutor_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <atomic>
+#include <memory>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/tExecutor.h"
+#include "plugins/rpc_ports/internal/tCallMailbox.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Executor for single-threaded servers
+/*!
+ * Executor that executes all calls one after the other in a single thread
+ * ("single-threaded server" or actor-style dispatch).
+ * Server functions of ports bound to this executor are never called concurrently -
+ * so they need not be thread-safe and require no locking.
+ *
+ * Calls are enqueued in a lock-free mailbox. They are either processed by a dispatch
+ * thread owned by the executor - or by calling ProcessCalls() (e.g. in a module's Update()).
+ * Calls from server functions to servers bound to the same executor are executed
+ * immediately in the calling thread (waiting for them would deadlock).
+ *
+ * Calls that have not been executed when the executor is destructed are discarded
+ * (callers waiting for their results receive BROKEN_PROMISE).
+ */
+class tSerialExecutor : public tExecutor
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * \param own_thread Create dispatch thread? If false, calls are only executed when ProcessCalls() is called.
+   */
+  explicit tSerialExecutor(bool own_thread = true);
+
+  /*! Stops and joins dispatch thread */
+  ~tSerialExecutor();
+
+  virtual void Execute(tTask && task) override;
+
+  /*!
+   * Executes all calls that are currently in the mailbox
+   * (for executors without own thread; must not be called concurrently)
+   *
+   * \return Number of executed calls
+   */
+  size_t ProcessCalls();
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Dispatch thread (defined in tSerialExecutor.cpp) */
+  class tDispatchThread;
+
+  /*! Calls waiting to be executed */
+  internal::tCallMailbox mailbox;
+
+  /*! Incremented when calls are added to empty mailbox while dispatch thread sleeps (dispatch thread waits on this word) */
+  std::atomic<int> wake_up_counter;
+
+  /*! True while dispatch thread sleeps or is about to (only then, Execute() needs to wake it up) */
+  std::atomic<bool> dispatcher_sleeping;
+
+  /*! True when dispatch thread is to stop */
+  std::atomic<bool> stop;
+
+  /*! Calls currently being processed (capacity is retained) */
+  std::vector<tTask> batch;
+
+  /*! Dispatch thread (NULL if executor has no own thread) */
+  std::shared_ptr<tDispatchThread> dispatch_thread;
+
+
+  /*!
+   * Main loop of dispatch thread
+   */
+  void Dispatch();
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
@@ -46,6 +46,7 @@
 // Internal includes with ""
 //----------------------------------------------------------------------
 #include "plugins/rpc_ports/tClientPort.h"
+#include "plugins/rpc_ports/tExecutor.h"
 #include "plugins/rpc_ports/tRPCInterfaceType.h"
 #include "plugins/rpc_ports/internal/tRPCPort.h"
 
@@ -92,6 +93,8 @@ public:
    * A framework element pointer is interpreted as parent.
    * tFrameworkElementFlag arguments are interpreted as flags.
    * tAbstractPortCreationInfo argument is copied. This is only allowed as first argument.
+   * A tExecutor reference is interpreted as executor that executes calls to this port (see tExecutor).
+   * A tServerSynchronization argument specifies how calls to server functions are synchronized.
    */
   template <typename TArgument1, typename ... TArguments>
   explicit tServerPort(TArgument1&& arg1, TArguments&& ... args)
@@ -105,7 +108,7 @@ public:
     }
     if (!(creation_info.flags.Raw() & core::tFrameworkElementFlags(core::tFrameworkElementFlag::DELETED).Raw())) // do not create port, if deleted flag is set
     {
-      this->SetWrapped(new internal::tRPCPort(creation_info, creation_info.server_interface));
+      this->SetWrapped(new internal::tRPCPort(creation_info, creation_info.server_interface, creation_info.executor, creation_info.synchronization));
     }
   }
 
@@ -138,7 +141,13 @@ public:
     /*! Pointer to server interface */
     T* server_interface;
 
-    tConstructorParameters() : server_interface(nullptr) {}
+    /*! Executor that executes calls to server port (nullptr: calls are executed by the threads that invoke them) */
+    tExecutor* executor;
+
+    /*! How calls to server functions are synchronized */
+    tServerSynchronization synchronization;
+
+    tConstructorParameters() : server_interface(nullptr), executor(nullptr), synchronization(tServerSynchronization::NONE) {}
 
     /*! Set methods for parameter-specific properties */
     void Set(const tConstructorParameters& other)
@@ -150,6 +159,16 @@ public:
     {
       this->server_interface = &server_interface;
     }
+
+    void Set(tExecutor& executor)
+    {
+      this->executor = &executor;
+    }
+
+    void Set(tServerSynchronization synchronization)
+    {
+      this->synchronization = synchronization;
+    }
   };
 //----------------------------------------------------------------------
 // Private fields and methods
@@ -0,0 +1,155 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/tThreadPoolExecutor.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/tThreadPoolExecutor.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/thread/tThread.h"
+#include <thread>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+class tThreadPoolExecutor::tWorkerThread : public rrlib::thread::tThread
+{
+public:
+  tWorkerThread(tThreadPoolExecutor& executor) :
+    rrlib::thread::tThread("RPC Thread Pool Worker"),
+    executor(executor)
+  {}
+
+  virtual void Run() override
+  {
+    executor.Work();
+  }
+
+private:
+
+  /*! Executor that this thread works for */
+  tThreadPoolExecutor& executor;
+};
+
+tThreadPoolExecutor::tThreadPoolExecutor(size_t thread_count) :
+  mutex(),
+  task_available(mutex),
+  tasks(),
+  stop(false),
+  threads()
+{
+  if (thread_count == 0)
+  {
+    thread_count = std::max<size_t>(1, std::thread::hardware_concurrency());
+  }
+  for (size_t i = 0; i < thread_count; i++)
+  {
+    threads.emplace_back(std::static_pointer_cast<tWorkerThread>((new tWorkerThread(*this))->GetSharedPtr()));
+    threads.back()->Start();
+  }
+}
+
+tThreadPoolExecutor::~tThreadPoolExecutor()
+{
+  {
+    rrlib::thread::tLock lock(mutex);
+    stop = true;
+    task_available.NotifyAll(lock);
+  }
+  for (auto & thread : threads)
+  {
+    thread->Join();
+  }
+  tasks.clear();
+}
+
+void tThreadPoolExecutor::Execute(tTask && task)
+{
+  rrlib::thread::tLock lock(mutex);
+  tasks.push_back(std::move(task));
+  task_available.Notify(lock);
+}
+
+void tThreadPoolExecutor::Work()
+{
+  while (true)
+  {
+    tTask task;
+    {
+      rrlib::thread::tLock lock(mutex);
+      while ((!stop) && tasks.empty())
+      {
+        task_available.Wait(lock);
+      }
+      if (stop)
+      {
+        return;
+      }
+      task = std::move(tasks.front());
+      tasks.pop_front();
+    }
+    Run(std::move(task));
+  }
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -0,0 +1,142 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/tThreadPoolExecutor.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tThreadPoolExecutor
+ *
+ * \b tThreadPoolExecutor
+ *
+ * Executor with a fixed number of worker threads.
+ * Calls to server ports bound to this executor are executed in parallel by the worker threads
+ * (e.g. so that CPU-heavy server functions do not block network threads or callers).
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__rpc_ports__tThreadPoolExecutor_h__
+#define __plugins__rpc_ports__tThreadPoolExecutor_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/thread/tConditionVariable.h"
+#include <deque>
+#include <memory>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/tExecutor.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Thread pool executor
+/*!
+ * Executor with a fixed number of worker threads.
+ * Calls to server ports bound to this executor are executed in parallel by the worker threads
+ * (e.g. so that CPU-heavy server functions do not block network threads or callers).
+ * Server functions must therefore be thread-safe.
+ *
+ * Tasks that have not been executed when the executor is destructed are discarded
+ * (callers waiting for their results receive BROKEN_PROMISE).
+ */
+class tThreadPoolExecutor : public tExecutor
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * \param thread_count Number of worker threads (0 means one thread per hardware thread)
+   */
+  explicit tThreadPoolExecutor(size_t thread_count = 0);
+
+  /*! Stops and joins worker threads */
+  ~tThreadPoolExecutor();
+
+  virtual void Execute(tTask && task) override;
+
+  /*!
+   * \return Number of worker threads
+   */
+  size_t GetThreadCount() const
+  {
+    return threads.size();
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Worker thread (defined in tThreadPoolExecutor.cpp) */
+  class tWorkerThread;
+
+  /*! Mutex for task queue */
+  rrlib::thread::tMutex mutex;
+
+  /*! Signalled when tasks are added to queue (or when executor is stopped) */
+  rrlib::thread::tConditionVariable task_available;
+
+  /*! Tasks waiting to be executed */
+  std::deque<tTask> tasks;
+
+  /*! True when worker threads are to stop */
+  bool stop;
+
+  /*! Worker threads */
+  std::vector<std::shared_ptr<tWorkerThread>> threads;
+
+
+  /*!
+   * Main loop of worker threads
+   */
+  void Work();
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
@@ -39,6 +39,9 @@
 //----------------------------------------------------------------------
 #include "plugins/rpc_ports/tClientPort.h"
 #include "plugins/rpc_ports/tServerPort.h"
+#include "plugins/rpc_ports/tSerialExecutor.h"
+#include "plugins/rpc_ports/tThreadPoolExecutor.h"
+#include <thread>
 
 //----------------------------------------------------------------------
 // Debugging
@@ -94,11 +97,66 @@ public:
 
 tRPCInterfaceType<tTestInterface> cTYPE("Test interface", &tTestInterface::Function, &tTestInterface::Test, &tTestInterface::StringTest);
 
+class tTimeoutTestInterface : public tRPCInterface
+{
+public:
+  int Function(int i)
+  {
+    return i;
+  }
+
+  int FunctionWithDefaultTimeout(int i)
+  {
+    return i;
+  }
+};
+
+tRPCInterfaceType<tTimeoutTestInterface> cTIMEOUT_TEST_TYPE("Timeout test interface", &tTimeoutTestInterface::Function,
+    WithDefaultTimeout(&tTimeoutTestInterface::FunctionWithDefaultTimeout, std::chrono::milliseconds(500)));
+
+class tWaitPolicyTestInterface : public tRPCInterface
+{
+public:
+  int Function(int value, int delay_ms)
+  {
+    if (delay_ms)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+    }
+    return value;
+  }
+};
+
+tRPCInterfaceType<tWaitPolicyTestInterface> cWAIT_POLICY_TEST_TYPE("Wait policy test interface", &tWaitPolicyTestInterface::Function);
+
+class tTimeoutTestResponseHandler : public tResponseHandler<int>
+{
+public:
+  tTimeoutTestResponseHandler() : status(tFutureStatus::PENDING), value(0) {}
+
+  virtual void HandleException(tFutureStatus exception_type) override
+  {
+    status = exception_type;
+  }
+
+  virtual void HandleResponse(int call_result) override
+  {
+    status = tFutureStatus::READY;
+    value = call_result;
+  }
+
+  tFutureStatus status;
+  int value;
+};
+
 
 class BasicOperationTest : public rrlib::util::tUnitTestSuite
 {
   RRLIB_UNIT_TESTS_BEGIN_SUITE(BasicOperationTest);
   RRLIB_UNIT_TESTS_ADD_TEST(Test);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestDefaultTimeouts);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestWaitPolicies);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestFailedCalls);
   RRLIB_UNIT_TESTS_END_SUITE;
 
   void Test()
@@ -113,11 +171,133 @@ class BasicOperationTest : public rrlib::util::tUnitTestSuite
     int m = client_port.CallSynchronous(std::chrono::seconds(2), &tTestInterface::Function, 4);
     RRLIB_UNIT_TESTS_EQUALITY(m, 16);
     FINROC_LOG_PRINT(DEBUG_VERBOSE_1, "Call returned ", m);
+    m = client_port.CallSynchronous(std::chrono::seconds(2), tWaitPolicy(tWaitMode::SPIN_THEN_BLOCK), &tTestInterface::Function, 5);
+    RRLIB_UNIT_TESTS_EQUALITY(m, 20);
+    m = client_port.CallSynchronous(std::chrono::seconds(2), FINROC_RPC_FUNCTION(&tTestInterface::Function), 6);
+    RRLIB_UNIT_TESTS_EQUALITY(m, 24);
+    tResult<int> result = client_port.TryCallSynchronous(std::chrono::seconds(2), &tTestInterface::Function, 7);
+    RRLIB_UNIT_TESTS_ASSERT(result.Ok());
+    RRLIB_UNIT_TESTS_EQUALITY(result.GetValue(), 28);
     client_port.Call(&tTestInterface::Test);
     RRLIB_UNIT_TESTS_ASSERT(test_called);
     client_port.Call(&tTestInterface::StringTest, "a string");
     RRLIB_UNIT_TESTS_EQUALITY(string_test_called_with, std::string("a string"));
   }
+
+  void TestDefaultTimeouts()
+  {
+    tTimeoutTestInterface test_interface;
+    tSerialExecutor executor(false); // calls are executed in ProcessCalls() - and dropped if their timeout has expired before
+    tClientPort<tTimeoutTestInterface> client_port("Client port");
+    tServerPort<tTimeoutTestInterface> server_port(test_interface, "Server port", executor);
+    client_port.ConnectTo(server_port);
+
+    // Fallback to cDEFAULT_TIMEOUT
+    RRLIB_UNIT_TESTS_ASSERT(client_port.GetDefaultTimeout() == rrlib::time::tDuration::zero());
+    RRLIB_UNIT_TESTS_ASSERT(client_port.GetTimeout(&tTimeoutTestInterface::Function) == internal::tRPCPort::cDEFAULT_TIMEOUT);
+
+    // Function default applies
+    RRLIB_UNIT_TESTS_ASSERT(client_port.GetTimeout(&tTimeoutTestInterface::FunctionWithDefaultTimeout) == std::chrono::milliseconds(500));
+    tTimeoutTestResponseHandler handler;
+    client_port.CallAsynchronous(handler, &tTimeoutTestInterface::FunctionWithDefaultTimeout, 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    executor.ProcessCalls();
+    RRLIB_UNIT_TESTS_EQUALITY(handler.status, tFutureStatus::READY);
+    RRLIB_UNIT_TESTS_EQUALITY(handler.value, 1);
+
+    // Timeout passed to call applies
+    tTimeoutTestResponseHandler handler2;
+    client_port.CallAsynchronous(std::chrono::milliseconds(5), handler2, &tTimeoutTestInterface::FunctionWithDefaultTimeout, 2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    executor.ProcessCalls();
+    RRLIB_UNIT_TESTS_EQUALITY(handler2.status, tFutureStatus::TIMEOUT);
+
+    // Port default overrides function default
+    client_port.SetDefaultTimeout(std::chrono::milliseconds(5));
+    RRLIB_UNIT_TESTS_ASSERT(client_port.GetDefaultTimeout() == std::chrono::milliseconds(5));
+    RRLIB_UNIT_TESTS_ASSERT(client_port.GetTimeout(&tTimeoutTestInterface::Function) == std::chrono::milliseconds(5));
+    RRLIB_UNIT_TESTS_ASSERT(client_port.GetTimeout(&tTimeoutTestInterface::FunctionWithDefaultTimeout) == std::chrono::milliseconds(5));
+    tTimeoutTestResponseHandler handler3;
+    client_port.CallAsynchronous(handler3, &tTimeoutTestInterface::FunctionWithDefaultTimeout, 3);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    executor.ProcessCalls();
+    RRLIB_UNIT_TESTS_EQUALITY(handler3.status, tFutureStatus::TIMEOUT);
+
+    // Resetting port default restores function default
+    client_port.SetDefaultTimeout(rrlib::time::tDuration::zero());
+    RRLIB_UNIT_TESTS_ASSERT(client_port.GetTimeout(&tTimeoutTestInterface::FunctionWithDefaultTimeout) == std::chrono::milliseconds(500));
+  }
+
+  void TestWaitPolicies()
+  {
+    // Results are provided by executor thread
+    tWaitPolicyTestInterface test_interface;
+    tThreadPoolExecutor executor(1);
+    tClientPort<tWaitPolicyTestInterface> client_port("Client port");
+    tServerPort<tWaitPolicyTestInterface> server_port(test_interface, "Server port", executor);
+    client_port.ConnectTo(server_port);
+
+    // Result arrives while spinning
+    for (int i = 0; i < 10; i++)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY(client_port.CallSynchronous(std::chrono::seconds(2), tWaitPolicy(tWaitMode::SPIN_THEN_BLOCK, 1000000), &tWaitPolicyTestInterface::Function, i, 0), i);
+    }
+
+    // Result arrives after spinning: thread blocks and is woken by executor thread
+    for (int i = 0; i < 10; i++)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY(client_port.CallSynchronous(std::chrono::seconds(2), tWaitPolicy(tWaitMode::SPIN_THEN_BLOCK, 10), &tWaitPolicyTestInterface::Function, i, 5), i);
+    }
+    tFuture<int> future = client_port.FutureCall(&tWaitPolicyTestInterface::Function, 1, 5);
+    RRLIB_UNIT_TESTS_EQUALITY(future.Get(std::chrono::seconds(2), tWaitPolicy(tWaitMode::SPIN_THEN_BLOCK, 10)), 1);
+
+    // Port's wait policy applies to calls without policy
+    client_port.SetWaitPolicy(tWaitPolicy(tWaitMode::SPIN_THEN_BLOCK, 10));
+    RRLIB_UNIT_TESTS_EQUALITY(client_port.CallSynchronous(std::chrono::seconds(2), &tWaitPolicyTestInterface::Function, 2, 5), 2);
+
+    // Thread polls until result arrives
+    RRLIB_UNIT_TESTS_EQUALITY(client_port.CallSynchronous(std::chrono::seconds(2), tWaitPolicy(tWaitMode::BUSY_POLL), &tWaitPolicyTestInterface::Function, 3, 5), 3);
+  }
+
+  void TestFailedCalls()
+  {
+    // Unconnected port
+    tClientPort<tWaitPolicyTestInterface> client_port("Client port");
+    tResult<int> result = client_port.TryCallSynchronous(std::chrono::seconds(2), &tWaitPolicyTestInterface::Function, 1, 0);
+    RRLIB_UNIT_TESTS_ASSERT(!result.Ok());
+    RRLIB_UNIT_TESTS_EQUALITY(result.GetStatus(), tFutureStatus::NO_CONNECTION);
+    result = client_port.FutureCall(&tWaitPolicyTestInterface::Function, 1, 0).TryGet(std::chrono::seconds(2));
+    RRLIB_UNIT_TESTS_EQUALITY(result.GetStatus(), tFutureStatus::NO_CONNECTION);
+    tFutureStatus thrown = tFutureStatus::PENDING;
+    try
+    {
+      client_port.CallSynchronous(std::chrono::seconds(2), &tWaitPolicyTestInterface::Function, 1, 0);
+    }
+    catch (const tRPCException& e)
+    {
+      thrown = e.GetType();
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(thrown, tFutureStatus::NO_CONNECTION);
+
+    // Server does not return result before timeout
+    tWaitPolicyTestInterface test_interface;
+    tThreadPoolExecutor executor(1);
+    tServerPort<tWaitPolicyTestInterface> server_port(test_interface, "Server port", executor);
+    client_port.ConnectTo(server_port);
+    result = client_port.TryCallSynchronous(std::chrono::milliseconds(10), &tWaitPolicyTestInterface::Function, 2, 100);
+    RRLIB_UNIT_TESTS_EQUALITY(result.GetStatus(), tFutureStatus::TIMEOUT);
+    result = client_port.TryCallSynchronous(std::chrono::milliseconds(10), tWaitPolicy(tWaitMode::SPIN_THEN_BLOCK), &tWaitPolicyTestInterface::Function, 3, 100);
+    RRLIB_UNIT_TESTS_EQUALITY(result.GetStatus(), tFutureStatus::TIMEOUT);
+
+    // Future remains valid if waiting for it times out
+    tFuture<int> future = client_port.FutureCall(std::chrono::seconds(2), &tWaitPolicyTestInterface::Function, 4, 100);
+    result = future.TryGet(std::chrono::milliseconds(10));
+    RRLIB_UNIT_TESTS_EQUALITY(result.GetStatus(), tFutureStatus::TIMEOUT);
+    RRLIB_UNIT_TESTS_ASSERT(future.Valid());
+    result = future.TryGet(std::chrono::seconds(2));
+    RRLIB_UNIT_TESTS_ASSERT(result.Ok());
+    RRLIB_UNIT_TESTS_EQUALITY(result.GetValue(), 4);
+  }
 };
 
 RRLIB_UNIT_TESTS_REGISTER_SUITE(BasicOperationTest);
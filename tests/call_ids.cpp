@@ -0,0 +1,171 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/tests/call_ids.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * Tests that call ids are unique across threads - and that threads insert calls into their own slot blocks.
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tUnitTestSuite.h"
+#include <algorithm>
+#include <thread>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/internal/tCallIdGenerator.h"
+#include "plugins/rpc_ports/internal/tPendingCallTable.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+/*! Number of threads used in tests */
+const size_t cCALL_ID_TEST_THREADS = 4;
+
+/*! Number of ids each thread generates (spans multiple id blocks) */
+const size_t cIDS_PER_THREAD = 3 * internal::tCallIdGenerator::cBLOCK_SIZE + 17;
+
+/*! Size of each thread's slot block in tPendingCallTable */
+const size_t cSLOT_BLOCK_SIZE = 64;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+class CallIdsTest : public rrlib::util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(CallIdsTest);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestGeneratorUniqueIds);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestThreadSlotBlocks);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+  void TestGeneratorUniqueIds()
+  {
+    std::vector<internal::tCallId> ids[cCALL_ID_TEST_THREADS];
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < cCALL_ID_TEST_THREADS; t++)
+    {
+      std::vector<internal::tCallId>& thread_ids = ids[t];
+      threads.emplace_back([&thread_ids]()
+      {
+        for (size_t i = 0; i < cIDS_PER_THREAD; i++)
+        {
+          thread_ids.push_back(internal::tCallIdGenerator::Next());
+        }
+      });
+    }
+    for (std::thread & thread : threads)
+    {
+      thread.join();
+    }
+
+    std::vector<internal::tCallId> all_ids;
+    for (auto & thread_ids : ids)
+    {
+      all_ids.insert(all_ids.end(), thread_ids.begin(), thread_ids.end());
+    }
+    RRLIB_UNIT_TESTS_ASSERT(std::find(all_ids.begin(), all_ids.end(), 0) == all_ids.end());
+    std::sort(all_ids.begin(), all_ids.end());
+    RRLIB_UNIT_TESTS_ASSERT(std::adjacent_find(all_ids.begin(), all_ids.end()) == all_ids.end());
+    RRLIB_UNIT_TESTS_EQUALITY(all_ids.size(), cCALL_ID_TEST_THREADS * cIDS_PER_THREAD);
+  }
+
+  void TestThreadSlotBlocks()
+  {
+    internal::tPendingCallTable table(4096);
+    size_t block_starts[cCALL_ID_TEST_THREADS];
+    std::atomic<size_t> errors(0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < cCALL_ID_TEST_THREADS; t++)
+    {
+      size_t& block_start = block_starts[t];
+      threads.emplace_back([&table, &block_start, &errors]()
+      {
+        // Fresh threads fill their own block - in consecutive slots
+        std::vector<internal::tCallId> call_ids;
+        for (size_t i = 0; i < cSLOT_BLOCK_SIZE; i++)
+        {
+          call_ids.push_back(table.Insert(internal::tRPCPort::tCallPointer(internal::tCallStorage::GetUnused().release()))->GetCallId());
+        }
+        block_start = table.GetSlotIndex(call_ids[0]);
+        for (size_t i = 0; i < cSLOT_BLOCK_SIZE; i++)
+        {
+          errors += (block_start % cSLOT_BLOCK_SIZE != 0 || table.GetSlotIndex(call_ids[i]) != block_start + i) ? 1 : 0;
+        }
+
+        // Slot that becomes free in own block is reused
+        table.Take(call_ids[10]);
+        call_ids[10] = table.Insert(internal::tRPCPort::tCallPointer(internal::tCallStorage::GetUnused().release()))->GetCallId();
+        errors += table.GetSlotIndex(call_ids[10]) != block_start + 10 ? 1 : 0;
+
+        for (internal::tCallId call_id : call_ids)
+        {
+          errors += table.Take(call_id) ? 0 : 1;
+        }
+      });
+    }
+    for (std::thread & thread : threads)
+    {
+      thread.join();
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(errors.load(), 0u);
+    std::sort(block_starts, block_starts + cCALL_ID_TEST_THREADS);
+    RRLIB_UNIT_TESTS_ASSERT(std::adjacent_find(block_starts, block_starts + cCALL_ID_TEST_THREADS) == block_starts + cCALL_ID_TEST_THREADS);
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(CallIdsTest);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -0,0 +1,284 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/tests/continuations.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * Tests continuations attached to futures with tFuture::Then().
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tUnitTestSuite.h"
+#include <thread>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/tClientPort.h"
+#include "plugins/rpc_ports/tServerPort.h"
+#include "plugins/rpc_ports/internal/tResponseSender.h"
+#include "plugins/rpc_ports/internal/tRPCInterfaceTypeInfo.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+/*! Maximum time any test waits for results */
+const rrlib::time::tDuration cMAX_WAIT = std::chrono::seconds(3);
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+class tContinuationTestInterface : public tRPCInterface
+{
+public:
+  int Square(int value)
+  {
+    return value * value;
+  }
+};
+
+tRPCInterfaceType<tContinuationTestInterface> cCONTINUATION_TEST_TYPE("Continuation test interface", &tContinuationTestInterface::Square);
+
+/*! Network port that keeps the calls sent to it */
+class tContinuationTestNetworkPort : public internal::tRPCPort
+{
+public:
+  tContinuationTestNetworkPort(core::tAbstractPortCreationInfo creation_info) : internal::tRPCPort(creation_info, NULL) {}
+
+  std::vector<tCallPointer> sent_calls;
+
+private:
+  virtual void SendCall(tCallPointer && call_to_send) override
+  {
+    sent_calls.push_back(std::move(call_to_send));
+  }
+};
+
+/*! Response sender that keeps the responses sent to it */
+class tContinuationTestResponseSender : public internal::tResponseSender
+{
+public:
+  std::vector<tCallPointer> responses;
+
+private:
+  virtual void SendResponse(tCallPointer && response_to_send) override
+  {
+    responses.push_back(std::move(response_to_send));
+  }
+};
+
+class ContinuationsTest : public rrlib::util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(ContinuationsTest);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestReadyFuture);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestPendingRemoteFuture);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestExceptionPropagation);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+  /*!
+   * Creates network port that client port is connected to
+   */
+  tContinuationTestNetworkPort* CreateNetworkPort(tClientPort<tContinuationTestInterface>& client_port)
+  {
+    core::tAbstractPortCreationInfo creation_info;
+    creation_info.name = "Network port";
+    creation_info.data_type = cCONTINUATION_TEST_TYPE;
+    creation_info.flags |= core::tFrameworkElement::tFlag::NETWORK_ELEMENT | core::tFrameworkElement::tFlag::ACCEPTS_DATA | core::tFrameworkElement::tFlag::EMITS_DATA;
+    tContinuationTestNetworkPort* network_port = new tContinuationTestNetworkPort(creation_info);
+    client_port.GetWrapped()->ConnectTo(*network_port);
+    return network_port;
+  }
+
+  void TestReadyFuture()
+  {
+    tContinuationTestInterface server_object;
+    tClientPort<tContinuationTestInterface> client_port("Client");
+    tServerPort<tContinuationTestInterface> server_port(server_object, "Server");
+    client_port.ConnectTo(server_port);
+
+    // Local call without executor returns future that is ready on creation: continuations are invoked immediately
+    tFuture<int> source = client_port.FutureCall(&tContinuationTestInterface::Square, 4);
+    RRLIB_UNIT_TESTS_ASSERT(source.Ready());
+    std::thread::id continuation_thread;
+    tFuture<int> future = source.Then([&continuation_thread](int value)
+    {
+      continuation_thread = std::this_thread::get_id();
+      return value + 1;
+    });
+    RRLIB_UNIT_TESTS_ASSERT(!source.Valid());
+    RRLIB_UNIT_TESTS_ASSERT(future.Ready());
+    RRLIB_UNIT_TESTS_ASSERT(continuation_thread == std::this_thread::get_id());
+    RRLIB_UNIT_TESTS_EQUALITY(future.Get(), 17);
+
+    // Callables returning futures are flattened
+    tFuture<int> chained = client_port.FutureCall(&tContinuationTestInterface::Square, 2).Then([&client_port](int value)
+    {
+      return client_port.FutureCall(&tContinuationTestInterface::Square, value);
+    });
+    RRLIB_UNIT_TESTS_EQUALITY(chained.Get(), 16);
+  }
+
+  void TestPendingRemoteFuture()
+  {
+    internal::tWireFormat client_side(internal::tWireFormat::tEncoding::COMPACT), server_side(internal::tWireFormat::tEncoding::COMPACT);
+    tClientPort<tContinuationTestInterface> client_port("Client");
+    tContinuationTestNetworkPort* network_port = CreateNetworkPort(client_port);
+    tContinuationTestInterface server_object;
+    tClientPort<tContinuationTestInterface> remote_client_port("Remote client");
+    tServerPort<tContinuationTestInterface> server_port(server_object, "Server");
+    remote_client_port.ConnectTo(server_port);
+
+    std::thread::id continuation_thread;
+    tFuture<int> future = client_port.FutureCall(cMAX_WAIT, &tContinuationTestInterface::Square, 6).Then([&continuation_thread](int value)
+    {
+      continuation_thread = std::this_thread::get_id();
+      return value + 1;
+    });
+    RRLIB_UNIT_TESTS_ASSERT(!future.Ready());
+    RRLIB_UNIT_TESTS_ASSERT(continuation_thread == std::thread::id());
+
+    // Simulate request and response transfer (memory streams)
+    RRLIB_UNIT_TESTS_EQUALITY(network_port->sent_calls.size(), 1u);
+    internal::tRPCPort::tCallPointer request = std::move(network_port->sent_calls[0]);
+    network_port->sent_calls.clear();
+    rrlib::serialization::tMemoryBuffer request_buffer;
+    {
+      rrlib::serialization::tOutputStream stream(request_buffer);
+      request->GetCall()->Serialize(stream, client_side);
+      stream.Close();
+    }
+    tContinuationTestResponseSender response_sender;
+    {
+      rrlib::serialization::tInputStream stream(request_buffer);
+      rrlib::rtti::tType type = server_side.ReadInterfaceType(stream);
+      uint8_t function_index;
+      stream >> function_index;
+      type.GetAnnotation<internal::tRPCInterfaceTypeInfo>()->DeserializeRequest(stream, *remote_client_port.GetWrapped(), function_index, response_sender, server_side);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(response_sender.responses.size(), 1u);
+    rrlib::serialization::tMemoryBuffer response_buffer;
+    {
+      rrlib::serialization::tOutputStream stream(response_buffer);
+      response_sender.responses[0]->GetCall()->Serialize(stream, server_side);
+      stream.Close();
+    }
+    RRLIB_UNIT_TESTS_ASSERT(!future.Ready());
+
+    // Continuation is invoked by the thread that receives the response
+    std::thread::id receiving_thread;
+    std::thread receiver([&]()
+    {
+      receiving_thread = std::this_thread::get_id();
+      rrlib::serialization::tInputStream stream(response_buffer);
+      rrlib::rtti::tType type = client_side.ReadInterfaceType(stream);
+      uint8_t function_index;
+      stream >> function_index;
+      client_side.ReadCallId(stream);
+      tContinuationTestResponseSender client_response_sender;
+      type.GetAnnotation<internal::tRPCInterfaceTypeInfo>()->DeserializeResponse(stream, function_index, client_response_sender, request.get(), client_side);
+    });
+    receiver.join();
+    RRLIB_UNIT_TESTS_ASSERT(future.Ready());
+    RRLIB_UNIT_TESTS_ASSERT(continuation_thread == receiving_thread);
+    RRLIB_UNIT_TESTS_EQUALITY(future.Get(), 37);
+  }
+
+  void TestExceptionPropagation()
+  {
+    bool invoked = false;
+    auto callable = [&invoked](int value)
+    {
+      invoked = true;
+      return value;
+    };
+
+    // Source fails immediately
+    tClientPort<tContinuationTestInterface> unconnected_port("Unconnected client");
+    tResult<int> result = unconnected_port.FutureCall(&tContinuationTestInterface::Square, 1).Then(callable).TryGet(cMAX_WAIT);
+    RRLIB_UNIT_TESTS_EQUALITY(result.GetStatus(), tFutureStatus::NO_CONNECTION);
+    RRLIB_UNIT_TESTS_ASSERT(!invoked);
+
+    // Pending source fails later
+    tClientPort<tContinuationTestInterface> client_port("Client");
+    tContinuationTestNetworkPort* network_port = CreateNetworkPort(client_port);
+    tFuture<int> future = client_port.FutureCall(std::chrono::milliseconds(10), &tContinuationTestInterface::Square, 2).Then(callable);
+    RRLIB_UNIT_TESTS_ASSERT(!future.Ready());
+    result = future.TryGet(cMAX_WAIT);
+    RRLIB_UNIT_TESTS_EQUALITY(result.GetStatus(), tFutureStatus::TIMEOUT);
+    RRLIB_UNIT_TESTS_ASSERT(!invoked);
+    network_port->sent_calls.clear();
+
+    // Callable throws
+    tContinuationTestInterface server_object;
+    tServerPort<tContinuationTestInterface> server_port(server_object, "Server");
+    unconnected_port.ConnectTo(server_port);
+    result = unconnected_port.FutureCall(&tContinuationTestInterface::Square, 3).Then([](int value) -> int
+    {
+      throw tRPCException(tFutureStatus::INVALID_CALL);
+    }).TryGet(cMAX_WAIT);
+    RRLIB_UNIT_TESTS_EQUALITY(result.GetStatus(), tFutureStatus::INVALID_CALL);
+
+    // Exceptions propagate through chains of continuations
+    result = unconnected_port.FutureCall(&tContinuationTestInterface::Square, 3).Then([](int value) -> int
+    {
+      throw tRPCException(tFutureStatus::INVALID_CALL);
+    }).Then(callable).TryGet(cMAX_WAIT);
+    RRLIB_UNIT_TESTS_EQUALITY(result.GetStatus(), tFutureStatus::INVALID_CALL);
+    RRLIB_UNIT_TESTS_ASSERT(!invoked);
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(ContinuationsTest);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
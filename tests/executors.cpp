@@ -0,0 +1,317 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/tests/executors.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * Tests execution of calls to server ports by executors.
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tUnitTestSuite.h"
+#include <thread>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/tClientPort.h"
+#include "plugins/rpc_ports/tServerPort.h"
+#include "plugins/rpc_ports/tSerialExecutor.h"
+#include "plugins/rpc_ports/tThreadPoolExecutor.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+/*! Maximum time any test waits for calls */
+const rrlib::time::tDuration cMAX_WAIT = std::chrono::seconds(3);
+
+/*! Number of calls in ordering tests */
+const int cORDERED_CALLS = 1000;
+
+/*! Number of threads calling servers concurrently */
+const int cCALLING_THREADS = 4;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+class tExecutorTestInterface : public tRPCInterface
+{
+public:
+  tExecutorTestInterface() :
+    values(),
+    blocked(false),
+    block_entered(false),
+    forward_client(NULL)
+  {}
+
+  void Append(int value)
+  {
+    values.push_back(value);
+  }
+
+  int Count()
+  {
+    return values.size();
+  }
+
+  /*!
+   * Blocks while 'blocked' is set
+   */
+  int Block(int value)
+  {
+    block_entered.store(true);
+    while (blocked.load())
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return value;
+  }
+
+  /*!
+   * Calls Block() via forward_client (server of forward_client is bound to the same serial executor)
+   */
+  int Forward(int value)
+  {
+    return forward_client->CallSynchronous(cMAX_WAIT, &tExecutorTestInterface::Block, value);
+  }
+
+  /*! Values passed to Append() */
+  std::vector<int> values;
+
+  /*! While true, calls to Block() do not return */
+  std::atomic<bool> blocked;
+
+  /*! Set when Block() is called */
+  std::atomic<bool> block_entered;
+
+  /*! Client port that Forward() calls */
+  tClientPort<tExecutorTestInterface>* forward_client;
+};
+
+tRPCInterfaceType<tExecutorTestInterface> cEXECUTOR_TEST_TYPE("Executor test interface", &tExecutorTestInterface::Append,
+    &tExecutorTestInterface::Count, &tExecutorTestInterface::Block, &tExecutorTestInterface::Forward);
+
+class ExecutorsTest : public rrlib::util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(ExecutorsTest);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestSerialExecutorOrder);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestSerialExecutorConcurrentCallers);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestSerialExecutorReentrantCall);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestThreadPoolExecutorOrder);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestPortDeletedWithQueuedCalls);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestPortDeletedWhileExecuting);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestExecutorDestructedWithQueuedCalls);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+  /*!
+   * Sends cORDERED_CALLS messages and checks that they were executed in order
+   */
+  void CheckOrder(tExecutor& executor)
+  {
+    tExecutorTestInterface server_interface;
+    tClientPort<tExecutorTestInterface> client("Client");
+    tServerPort<tExecutorTestInterface> server(server_interface, "Server", executor);
+    client.ConnectTo(server);
+
+    for (int i = 0; i < cORDERED_CALLS; i++)
+    {
+      client.Call(&tExecutorTestInterface::Append, i);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(client.CallSynchronous(cMAX_WAIT, &tExecutorTestInterface::Count), cORDERED_CALLS);
+    for (int i = 0; i < cORDERED_CALLS; i++)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY(server_interface.values[i], i);
+    }
+    server.ManagedDelete();
+  }
+
+  void TestSerialExecutorOrder()
+  {
+    tSerialExecutor executor;
+    CheckOrder(executor);
+  }
+
+  void TestSerialExecutorConcurrentCallers()
+  {
+    // Calls of each thread are executed in order - and never concurrently (server functions are not thread-safe)
+    tSerialExecutor executor;
+    tExecutorTestInterface server_interface;
+    tClientPort<tExecutorTestInterface> client("Client");
+    tServerPort<tExecutorTestInterface> server(server_interface, "Server", executor);
+    client.ConnectTo(server);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < cCALLING_THREADS; i++)
+    {
+      threads.emplace_back([&, i]()
+      {
+        for (int j = 0; j < cORDERED_CALLS; j++)
+        {
+          client.Call(&tExecutorTestInterface::Append, i * cORDERED_CALLS + j);
+          if (j % 100 == 0)
+          {
+            std::this_thread::sleep_for(std::chrono::microseconds(100)); // let dispatch thread go to sleep occasionally
+          }
+        }
+      });
+    }
+    for (std::thread & thread : threads)
+    {
+      thread.join();
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(client.CallSynchronous(cMAX_WAIT, &tExecutorTestInterface::Count), cCALLING_THREADS * cORDERED_CALLS);
+    std::vector<int> next_values(cCALLING_THREADS);
+    for (int value : server_interface.values)
+    {
+      int thread_index = value / cORDERED_CALLS;
+      RRLIB_UNIT_TESTS_EQUALITY(value % cORDERED_CALLS, next_values[thread_index]);
+      next_values[thread_index]++;
+    }
+    server.ManagedDelete();
+  }
+
+  void TestSerialExecutorReentrantCall()
+  {
+    // Server function calls another server bound to the same executor: call is executed immediately (instead of deadlocking)
+    tSerialExecutor executor;
+    tExecutorTestInterface server_interface, other_server_interface;
+    tClientPort<tExecutorTestInterface> client("Client");
+    tClientPort<tExecutorTestInterface> forward_client("Forward client");
+    tServerPort<tExecutorTestInterface> server(server_interface, "Server", executor);
+    tServerPort<tExecutorTestInterface> other_server(other_server_interface, "Other server", executor);
+    client.ConnectTo(server);
+    forward_client.ConnectTo(other_server);
+    server_interface.forward_client = &forward_client;
+
+    RRLIB_UNIT_TESTS_EQUALITY(client.CallSynchronous(cMAX_WAIT, &tExecutorTestInterface::Forward, 5), 5);
+    RRLIB_UNIT_TESTS_ASSERT(other_server_interface.block_entered.load());
+    server.ManagedDelete();
+    other_server.ManagedDelete();
+  }
+
+  void TestThreadPoolExecutorOrder()
+  {
+    // Calls are executed in order if pool has only one thread
+    tThreadPoolExecutor executor(1);
+    CheckOrder(executor);
+  }
+
+  void TestPortDeletedWithQueuedCalls()
+  {
+    tSerialExecutor executor(false);
+    tExecutorTestInterface server_interface;
+    tClientPort<tExecutorTestInterface> client("Client");
+    tServerPort<tExecutorTestInterface> server(server_interface, "Server", executor);
+    client.ConnectTo(server);
+
+    client.Call(&tExecutorTestInterface::Append, 1);
+    tFuture<int> future = client.FutureCall(cMAX_WAIT, &tExecutorTestInterface::Count);
+    server.ManagedDelete();
+
+    // Queued calls do not access server interface anymore
+    RRLIB_UNIT_TESTS_EQUALITY(executor.ProcessCalls(), 2u);
+    RRLIB_UNIT_TESTS_EQUALITY(future.TryGet(rrlib::time::tDuration::zero()).GetStatus(), tFutureStatus::NO_CONNECTION);
+    RRLIB_UNIT_TESTS_ASSERT(server_interface.values.empty());
+  }
+
+  void TestPortDeletedWhileExecuting()
+  {
+    tThreadPoolExecutor executor(1);
+    tExecutorTestInterface server_interface;
+    tClientPort<tExecutorTestInterface> client("Client");
+    tServerPort<tExecutorTestInterface> server(server_interface, "Server", executor);
+    client.ConnectTo(server);
+
+    server_interface.blocked.store(true);
+    tFuture<int> executing_call = client.FutureCall(cMAX_WAIT, &tExecutorTestInterface::Block, 1);
+    tFuture<int> queued_call = client.FutureCall(cMAX_WAIT, &tExecutorTestInterface::Block, 2);
+    while (!server_interface.block_entered.load())
+    {
+      std::this_thread::yield();
+    }
+
+    // Deletion waits for call that is currently executed
+    std::atomic<bool> deleted(false);
+    std::thread deleting_thread([&]()
+    {
+      server.ManagedDelete();
+      deleted.store(true);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    RRLIB_UNIT_TESTS_ASSERT(!deleted.load());
+    server_interface.blocked.store(false);
+    deleting_thread.join();
+
+    RRLIB_UNIT_TESTS_EQUALITY(executing_call.Get(cMAX_WAIT), 1);
+    RRLIB_UNIT_TESTS_EQUALITY(queued_call.TryGet(cMAX_WAIT).GetStatus(), tFutureStatus::NO_CONNECTION);
+  }
+
+  void TestExecutorDestructedWithQueuedCalls()
+  {
+    std::unique_ptr<tSerialExecutor> executor(new tSerialExecutor(false));
+    tExecutorTestInterface server_interface;
+    tClientPort<tExecutorTestInterface> client("Client");
+    tServerPort<tExecutorTestInterface> server(server_interface, "Server", *executor);
+    client.ConnectTo(server);
+
+    tFuture<int> future = client.FutureCall(cMAX_WAIT, &tExecutorTestInterface::Count);
+    server.ManagedDelete();
+    executor.reset();
+    RRLIB_UNIT_TESTS_EQUALITY(future.TryGet(rrlib::time::tDuration::zero()).GetStatus(), tFutureStatus::BROKEN_PROMISE);
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(ExecutorsTest);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -0,0 +1,248 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/tests/parameter_cache.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * Tests reuse of parameter tuples that incoming calls are deserialized into.
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tUnitTestSuite.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/tClientPort.h"
+#include "plugins/rpc_ports/tServerPort.h"
+#include "plugins/rpc_ports/internal/tParameterCache.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+class tParameterCacheTestInterface : public tRPCInterface
+{
+public:
+  tParameterCacheTestInterface() :
+    string_value(),
+    string_data(NULL),
+    string_capacity(0),
+    buffer_size(0)
+  {}
+
+  void StoreString(const std::string& value)
+  {
+    string_value = value;
+    string_data = value.data();
+    string_capacity = value.capacity();
+  }
+
+  void StoreBufferSize(const tRPCBuffer& buffer)
+  {
+    buffer_size = buffer.Size();
+  }
+
+  /*! Last string passed to StoreString() */
+  std::string string_value;
+
+  /*! Address and capacity of the last string parameter passed to StoreString() */
+  const char* string_data;
+  size_t string_capacity;
+
+  /*! Size of last buffer passed to StoreBufferSize() */
+  size_t buffer_size;
+};
+
+tRPCInterfaceType<tParameterCacheTestInterface> cPARAMETER_CACHE_TEST_TYPE("Parameter cache test interface", &tParameterCacheTestInterface::StoreString,
+    &tParameterCacheTestInterface::StoreBufferSize);
+
+/*! Network port that keeps the calls sent to it */
+class tParameterCacheTestNetworkPort : public internal::tRPCPort
+{
+public:
+  tParameterCacheTestNetworkPort(core::tAbstractPortCreationInfo creation_info) : internal::tRPCPort(creation_info, NULL) {}
+
+  std::vector<tCallPointer> sent_calls;
+
+private:
+  virtual void SendCall(tCallPointer && call_to_send) override
+  {
+    sent_calls.push_back(std::move(call_to_send));
+  }
+};
+
+/*! Buffer transfer that hands received payloads to servers as views into a receive buffer */
+class tParameterCacheTestBufferTransfer : public internal::tWireFormat::tBufferTransfer
+{
+public:
+  tParameterCacheTestBufferTransfer() :
+    receive_buffer(new std::vector<uint8_t>())
+  {}
+
+  virtual tRPCBuffer ReadBuffer(rrlib::serialization::tInputStream& stream, size_t size) override
+  {
+    receive_buffer->resize(size);
+    stream.ReadFully(receive_buffer->data(), size);
+    return tRPCBuffer(receive_buffer->data(), size, receive_buffer);
+  }
+
+  virtual void WriteBuffer(rrlib::serialization::tOutputStream& stream, const tRPCBuffer& buffer) override
+  {
+    stream.Write(buffer.Data(), buffer.Size());
+  }
+
+  /*! Receive buffer of simulated transport */
+  std::shared_ptr<std::vector<uint8_t>> receive_buffer;
+};
+
+class ParameterCacheTest : public rrlib::util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(ParameterCacheTest);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestStringCapacity);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestBufferReleased);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestNestedUse);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+  tParameterCacheTestInterface server_object;
+
+  /*!
+   * Sends message from client port over simulated connection (memory stream) and deserializes it on server side
+   */
+  template <typename TFunction, typename TArg>
+  void SendMessage(TFunction function, TArg && arg, internal::tWireFormat& server_side)
+  {
+    tClientPort<tParameterCacheTestInterface> client_port("Client");
+    core::tAbstractPortCreationInfo creation_info;
+    creation_info.name = "Network port";
+    creation_info.data_type = cPARAMETER_CACHE_TEST_TYPE;
+    creation_info.flags |= core::tFrameworkElement::tFlag::NETWORK_ELEMENT | core::tFrameworkElement::tFlag::ACCEPTS_DATA | core::tFrameworkElement::tFlag::EMITS_DATA;
+    tParameterCacheTestNetworkPort* network_port = new tParameterCacheTestNetworkPort(creation_info);
+    client_port.GetWrapped()->ConnectTo(*network_port);
+    tClientPort<tParameterCacheTestInterface> remote_client_port("Remote client");
+    tServerPort<tParameterCacheTestInterface> server_port(server_object, "Server");
+    remote_client_port.ConnectTo(server_port);
+
+    client_port.Call(function, std::forward<TArg>(arg));
+    RRLIB_UNIT_TESTS_EQUALITY(network_port->sent_calls.size(), 1u);
+    internal::tWireFormat client_side(server_side.GetEncoding());
+    rrlib::serialization::tMemoryBuffer message_buffer;
+    {
+      rrlib::serialization::tOutputStream stream(message_buffer);
+      network_port->sent_calls[0]->GetCall()->Serialize(stream, client_side);
+      stream.Close();
+    }
+    network_port->sent_calls.clear();
+
+    rrlib::serialization::tInputStream stream(message_buffer);
+    rrlib::rtti::tType type = server_side.ReadInterfaceType(stream);
+    uint8_t function_index;
+    stream >> function_index;
+    type.GetAnnotation<internal::tRPCInterfaceTypeInfo>()->DeserializeMessage(stream, *remote_client_port.GetWrapped(), function_index, server_side);
+    server_side.Reset();
+  }
+
+  void TestStringCapacity()
+  {
+    // Second message is deserialized into the string of the first one - which keeps its heap buffer
+    internal::tWireFormat server_side(internal::tWireFormat::tEncoding::COMPACT);
+    SendMessage(&tParameterCacheTestInterface::StoreString, std::string(200, 'a'), server_side);
+    RRLIB_UNIT_TESTS_EQUALITY(server_object.string_value, std::string(200, 'a'));
+    const char* first_data = server_object.string_data;
+    SendMessage(&tParameterCacheTestInterface::StoreString, std::string("short"), server_side);
+    RRLIB_UNIT_TESTS_EQUALITY(server_object.string_value, std::string("short"));
+    RRLIB_UNIT_TESTS_EQUALITY(server_object.string_data, first_data);
+    RRLIB_UNIT_TESTS_ASSERT(server_object.string_capacity >= 200);
+  }
+
+  void TestBufferReleased()
+  {
+    // Cached tuple must not keep receive buffer of transport alive after call
+    internal::tWireFormat server_side(internal::tWireFormat::tEncoding::COMPACT);
+    tParameterCacheTestBufferTransfer buffer_transfer;
+    server_side.SetBufferTransfer(&buffer_transfer);
+    SendMessage(&tParameterCacheTestInterface::StoreBufferSize, tRPCBuffer(std::vector<uint8_t>(100, 1)), server_side);
+    RRLIB_UNIT_TESTS_EQUALITY(server_object.buffer_size, 100u);
+    RRLIB_UNIT_TESTS_EQUALITY(buffer_transfer.receive_buffer.use_count(), 1);
+  }
+
+  void TestNestedUse()
+  {
+    typedef std::tuple<std::string> tParameterTuple;
+    typedef internal::tParameterCache<tParameterTuple, tParameterCacheTestInterface, void (tParameterCacheTestInterface::*)(const std::string&)> tCache;
+    tParameterTuple* cached_tuple = NULL;
+    {
+      tCache outer;
+      cached_tuple = &outer.Get();
+      std::get<0>(outer.Get()) = "outer";
+      {
+        // e.g. server function that receives another call with the same signature in the same thread
+        tCache inner;
+        RRLIB_UNIT_TESTS_ASSERT(&inner.Get() != cached_tuple);
+        std::get<0>(inner.Get()) = "inner";
+      }
+      RRLIB_UNIT_TESTS_EQUALITY(std::get<0>(outer.Get()), std::string("outer"));
+    }
+
+    // Cached tuple is available again
+    tCache cache;
+    RRLIB_UNIT_TESTS_EQUALITY(&cache.Get(), cached_tuple);
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(ParameterCacheTest);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -0,0 +1,272 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/tests/pending_call_table.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * Tests the pending call table that network transports use to match responses to their requests.
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tUnitTestSuite.h"
+#include <thread>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/internal/tPendingCallTable.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+typedef internal::tCallId tCallId;
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+/*! Number of threads and iterations per thread in stress test */
+const size_t cSTRESS_THREADS = 4, cSTRESS_ITERATIONS = 20000, cSTRESS_BATCH_SIZE = 8;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+/*! Records exception that call was completed with */
+class tStatusRecorder : public internal::tAbstractResponseHandler
+{
+public:
+  tStatusRecorder() : status(tFutureStatus::PENDING) {}
+
+  virtual void HandleException(tFutureStatus exception_type) override
+  {
+    status = exception_type;
+  }
+
+  tFutureStatus status;
+};
+
+class PendingCallTableTest : public rrlib::util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(PendingCallTableTest);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestInsertTake);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestStaleIds);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestClear);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestRemovedBeforeSerialization);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestTableFull);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestConcurrentInsertTake);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+  static internal::tRPCPort::tCallPointer CreateCall()
+  {
+    return internal::tRPCPort::tCallPointer(internal::tCallStorage::GetUnused().release());
+  }
+
+  void TestInsertTake()
+  {
+    internal::tPendingCallTable table(16);
+    RRLIB_UNIT_TESTS_EQUALITY(table.Capacity(), 16u);
+    internal::tRPCPort::tCallPointer call = CreateCall();
+    internal::tCallStorage* call_address = call.get();
+    tCallId call_id = table.Insert(std::move(call))->GetCallId();
+    RRLIB_UNIT_TESTS_ASSERT(call_id != 0);
+    RRLIB_UNIT_TESTS_EQUALITY(call_address->GetCallId(), call_id);
+
+    internal::tRPCPort::tCallPointer taken = table.Take(call_id);
+    RRLIB_UNIT_TESTS_EQUALITY(taken.get(), call_address);
+    RRLIB_UNIT_TESTS_ASSERT(!table.Take(call_id));
+  }
+
+  void TestStaleIds()
+  {
+    // Fill table - so that the next call is inserted into the slot that is freed
+    internal::tPendingCallTable table(4);
+    std::vector<tCallId> call_ids;
+    for (size_t i = 0; i < table.Capacity(); i++)
+    {
+      call_ids.push_back(table.Insert(CreateCall())->GetCallId());
+    }
+    tCallId old_id = call_ids[1];
+    RRLIB_UNIT_TESTS_ASSERT(table.Take(old_id));
+
+    tCallId new_id = table.Insert(CreateCall())->GetCallId();
+    RRLIB_UNIT_TESTS_EQUALITY(table.GetSlotIndex(new_id), table.GetSlotIndex(old_id));
+    RRLIB_UNIT_TESTS_ASSERT(new_id != old_id);
+
+    // Late response to old call and duplicate response to new call
+    RRLIB_UNIT_TESTS_ASSERT(!table.Take(old_id));
+    RRLIB_UNIT_TESTS_ASSERT(table.Take(new_id));
+    RRLIB_UNIT_TESTS_ASSERT(!table.Take(new_id));
+
+    // Unknown ids
+    RRLIB_UNIT_TESTS_ASSERT(!table.Take(0));
+    RRLIB_UNIT_TESTS_ASSERT(!table.Take(call_ids[0] + table.Capacity()));
+  }
+
+  void TestClear()
+  {
+    internal::tPendingCallTable table(16);
+    tStatusRecorder pending_recorders[3];
+    std::vector<tCallId> call_ids;
+    for (tStatusRecorder & recorder : pending_recorders)
+    {
+      internal::tRPCPort::tCallPointer call = CreateCall();
+      call->AttachResponseHandler(&recorder);
+      call_ids.push_back(table.Insert(std::move(call))->GetCallId());
+    }
+    tStatusRecorder completed_recorder;
+    internal::tRPCPort::tCallPointer completed_call = CreateCall();
+    completed_call->AttachResponseHandler(&completed_recorder);
+    internal::tCallStorage* completed_call_address = completed_call.get();
+    call_ids.push_back(table.Insert(std::move(completed_call))->GetCallId());
+    completed_call_address->SetException(tFutureStatus::TIMEOUT);
+
+    table.Clear(tFutureStatus::NO_CONNECTION);
+    for (tStatusRecorder & recorder : pending_recorders)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY(recorder.status, tFutureStatus::NO_CONNECTION);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(completed_recorder.status, tFutureStatus::TIMEOUT);
+    for (tCallId call_id : call_ids)
+    {
+      RRLIB_UNIT_TESTS_ASSERT(!table.Take(call_id));
+    }
+  }
+
+  void TestRemovedBeforeSerialization()
+  {
+    // Call times out and is removed from table before transport serializes it
+    internal::tPendingCallTable table(16);
+    tStatusRecorder recorder;
+    internal::tRPCPort::tCallPointer call = CreateCall();
+    call->AttachResponseHandler(&recorder);
+    internal::tCallStorage* call_address = call.get();
+    internal::tCallStorage::tFuturePointer reference = table.Insert(std::move(call));
+    tCallId call_id = reference->GetCallId();
+    call_address->SetException(tFutureStatus::TIMEOUT);
+    RRLIB_UNIT_TESTS_EQUALITY(table.RemoveCompleted(), 1u);
+    RRLIB_UNIT_TESTS_ASSERT(!table.Take(call_id));
+
+    // Storage must not be recycled before reference is released
+    internal::tCallStorage::tPointer other_call = internal::tCallStorage::GetUnused();
+    RRLIB_UNIT_TESTS_ASSERT(other_call.get() != call_address);
+    RRLIB_UNIT_TESTS_EQUALITY(reference.get(), call_address);
+    RRLIB_UNIT_TESTS_EQUALITY(reference->GetCallId(), call_id);
+    RRLIB_UNIT_TESTS_EQUALITY(reference->GetFutureStatus(), tFutureStatus::TIMEOUT);
+    RRLIB_UNIT_TESTS_EQUALITY(recorder.status, tFutureStatus::TIMEOUT);
+  }
+
+  void TestTableFull()
+  {
+    internal::tPendingCallTable table(4);
+    std::vector<tCallId> call_ids;
+    for (size_t i = 0; i < table.Capacity(); i++)
+    {
+      call_ids.push_back(table.Insert(CreateCall())->GetCallId());
+    }
+    bool thrown = false;
+    try
+    {
+      table.Insert(CreateCall());
+    }
+    catch (const std::runtime_error&)
+    {
+      thrown = true;
+    }
+    RRLIB_UNIT_TESTS_ASSERT(thrown);
+
+    // Calls already in table are not affected
+    for (tCallId call_id : call_ids)
+    {
+      RRLIB_UNIT_TESTS_ASSERT(table.Take(call_id));
+    }
+    RRLIB_UNIT_TESTS_ASSERT(table.Insert(CreateCall())->GetCallId() != 0);
+  }
+
+  void TestConcurrentInsertTake()
+  {
+    internal::tPendingCallTable table(64);
+    std::atomic<size_t> errors(0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < cSTRESS_THREADS; t++)
+    {
+      threads.emplace_back([&]()
+      {
+        tCallId call_ids[cSTRESS_BATCH_SIZE];
+        internal::tCallStorage* calls[cSTRESS_BATCH_SIZE];
+        for (size_t i = 0; i < cSTRESS_ITERATIONS; i++)
+        {
+          for (size_t j = 0; j < cSTRESS_BATCH_SIZE; j++)
+          {
+            internal::tRPCPort::tCallPointer call = CreateCall();
+            calls[j] = call.get();
+            call_ids[j] = table.Insert(std::move(call))->GetCallId();
+          }
+          for (size_t j = 0; j < cSTRESS_BATCH_SIZE; j++)
+          {
+            internal::tRPCPort::tCallPointer call = table.Take(call_ids[j]);
+            if (call.get() != calls[j] || call->GetCallId() != call_ids[j] || table.Take(call_ids[j]))
+            {
+              errors++;
+            }
+          }
+        }
+      });
+    }
+    for (std::thread & thread : threads)
+    {
+      thread.join();
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(errors.load(), 0u);
+    RRLIB_UNIT_TESTS_EQUALITY(table.RemoveCompleted(), 0u);
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(PendingCallTableTest);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -0,0 +1,299 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/tests/server_synchronization.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * Tests synchronization of calls to server ports in READER_WRITER mode.
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tUnitTestSuite.h"
+#include <thread>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/tClientPort.h"
+#include "plugins/rpc_ports/tServerPort.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+/*! Maximum time any test waits for other threads */
+const rrlib::time::tDuration cMAX_WAIT = std::chrono::seconds(3);
+
+/*! Number of threads calling server functions concurrently */
+const size_t cCALLING_THREADS = 4;
+
+/*! Number of calls per thread in stress test */
+const size_t cCALLS_PER_THREAD = 300;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+class tServerSynchronizationTestInterface : public tRPCInterface
+{
+public:
+  tServerSynchronizationTestInterface() :
+    client(NULL),
+    value(0),
+    readers(0),
+    max_readers(0),
+    writers(0),
+    violation(false),
+    block_readers(false)
+  {}
+
+  /*!
+   * Waits until the specified number of readers were in this function concurrently - and while readers are blocked
+   *
+   * \return Current value
+   */
+  int Get(int wait_for_readers) const
+  {
+    int current_readers = ++readers;
+    int max = max_readers.load();
+    while (current_readers > max && !max_readers.compare_exchange_weak(max, current_readers))
+    {
+    }
+    if (writers.load())
+    {
+      violation = true;
+    }
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + cMAX_WAIT;
+    while ((max_readers.load() < wait_for_readers || block_readers.load()) && std::chrono::steady_clock::now() < deadline)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    int result = value;
+    readers--;
+    return result;
+  }
+
+  int Set(int new_value)
+  {
+    if (writers++ || readers.load())
+    {
+      violation = true;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+    value = new_value;
+    writers--;
+    return new_value;
+  }
+
+  /*!
+   * Calls Get() via client port while holding server lock in exclusive mode
+   */
+  int SetAndGet(int new_value)
+  {
+    value = new_value;
+    return client->CallSynchronous(cMAX_WAIT, &tServerSynchronizationTestInterface::Get, 0);
+  }
+
+  /*!
+   * Calls Set() via client port while holding server lock in shared mode
+   *
+   * \return Status of call to Set()
+   */
+  int GetAndSet(int new_value) const
+  {
+    return static_cast<int>(client->TryCallSynchronous(cMAX_WAIT, &tServerSynchronizationTestInterface::Set, new_value).GetStatus());
+  }
+
+  /*! Client port connected to server port of this object (for re-entrant calls) */
+  tClientPort<tServerSynchronizationTestInterface>* client;
+
+  /*! Value that is set and returned */
+  int value;
+
+  /*! Number of readers currently in Get() - and maximum number of concurrent readers */
+  mutable std::atomic<int> readers, max_readers;
+
+  /*! Number of writers currently in Set() */
+  std::atomic<int> writers;
+
+  /*! Set when a reader and a writer - or two writers - were in functions concurrently */
+  mutable std::atomic<bool> violation;
+
+  /*! While true, readers do not leave Get() */
+  std::atomic<bool> block_readers;
+};
+
+tRPCInterfaceType<tServerSynchronizationTestInterface> cSERVER_SYNCHRONIZATION_TEST_TYPE("Server synchronization test interface",
+    &tServerSynchronizationTestInterface::Get, &tServerSynchronizationTestInterface::Set,
+    &tServerSynchronizationTestInterface::SetAndGet, &tServerSynchronizationTestInterface::GetAndSet);
+
+class ServerSynchronizationTest : public rrlib::util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(ServerSynchronizationTest);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestConcurrentReaders);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestExclusiveWriters);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestReentrantCalls);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestWriterWaitsForReaders);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+  void TestConcurrentReaders()
+  {
+    tServerSynchronizationTestInterface server_interface;
+    tClientPort<tServerSynchronizationTestInterface> client("Client");
+    tServerPort<tServerSynchronizationTestInterface> server(server_interface, "Server", tServerSynchronization::READER_WRITER);
+    client.ConnectTo(server);
+
+    // Each reader waits until all readers are in Get()
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < cCALLING_THREADS; i++)
+    {
+      threads.emplace_back([&]()
+      {
+        client.CallSynchronous(cMAX_WAIT, &tServerSynchronizationTestInterface::Get, static_cast<int>(cCALLING_THREADS));
+      });
+    }
+    for (std::thread & thread : threads)
+    {
+      thread.join();
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(server_interface.max_readers.load(), static_cast<int>(cCALLING_THREADS));
+    RRLIB_UNIT_TESTS_ASSERT(!server_interface.violation.load());
+  }
+
+  void TestExclusiveWriters()
+  {
+    tServerSynchronizationTestInterface server_interface;
+    tClientPort<tServerSynchronizationTestInterface> client("Client");
+    tServerPort<tServerSynchronizationTestInterface> server(server_interface, "Server", tServerSynchronization::READER_WRITER);
+    client.ConnectTo(server);
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < cCALLING_THREADS; i++)
+    {
+      threads.emplace_back([&, i]()
+      {
+        for (size_t j = 0; j < cCALLS_PER_THREAD; j++)
+        {
+          if ((i + j) % 4 == 0)
+          {
+            client.CallSynchronous(cMAX_WAIT, &tServerSynchronizationTestInterface::Set, static_cast<int>(j));
+          }
+          else
+          {
+            client.CallSynchronous(cMAX_WAIT, &tServerSynchronizationTestInterface::Get, 0);
+          }
+        }
+      });
+    }
+    for (std::thread & thread : threads)
+    {
+      thread.join();
+    }
+    RRLIB_UNIT_TESTS_ASSERT(!server_interface.violation.load());
+  }
+
+  void TestReentrantCalls()
+  {
+    tServerSynchronizationTestInterface server_interface;
+    tClientPort<tServerSynchronizationTestInterface> client("Client");
+    tServerPort<tServerSynchronizationTestInterface> server(server_interface, "Server", tServerSynchronization::READER_WRITER);
+    client.ConnectTo(server);
+    server_interface.client = &client;
+
+    // Thread holding lock in exclusive mode may call const functions - but thread holding it in shared mode must not call non-const functions
+    RRLIB_UNIT_TESTS_EQUALITY(client.CallSynchronous(cMAX_WAIT, &tServerSynchronizationTestInterface::SetAndGet, 42), 42);
+    RRLIB_UNIT_TESTS_EQUALITY(client.CallSynchronous(cMAX_WAIT, &tServerSynchronizationTestInterface::GetAndSet, 7), static_cast<int>(tFutureStatus::INVALID_CALL));
+    RRLIB_UNIT_TESTS_EQUALITY(server_interface.value, 42);
+
+    // Lock is released properly after re-entrant calls
+    RRLIB_UNIT_TESTS_EQUALITY(client.CallSynchronous(cMAX_WAIT, &tServerSynchronizationTestInterface::Set, 8), 8);
+    RRLIB_UNIT_TESTS_EQUALITY(client.CallSynchronous(cMAX_WAIT, &tServerSynchronizationTestInterface::Get, 0), 8);
+  }
+
+  void TestWriterWaitsForReaders()
+  {
+    tServerSynchronizationTestInterface server_interface;
+    tClientPort<tServerSynchronizationTestInterface> client("Client");
+    tServerPort<tServerSynchronizationTestInterface> server(server_interface, "Server", tServerSynchronization::READER_WRITER);
+    client.ConnectTo(server);
+
+    server_interface.block_readers.store(true);
+    std::thread reader([&]()
+    {
+      client.CallSynchronous(cMAX_WAIT, &tServerSynchronizationTestInterface::Get, 0);
+    });
+    while (server_interface.readers.load() == 0)
+    {
+      std::this_thread::yield();
+    }
+    std::atomic<bool> set_returned(false);
+    std::thread writer([&]()
+    {
+      client.CallSynchronous(cMAX_WAIT, &tServerSynchronizationTestInterface::Set, 1);
+      set_returned.store(true);
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    RRLIB_UNIT_TESTS_ASSERT(!set_returned.load());
+    RRLIB_UNIT_TESTS_EQUALITY(server_interface.writers.load(), 0);
+    server_interface.block_readers.store(false);
+    reader.join();
+    writer.join();
+    RRLIB_UNIT_TESTS_ASSERT(set_returned.load());
+    RRLIB_UNIT_TESTS_EQUALITY(server_interface.value, 1);
+    RRLIB_UNIT_TESTS_ASSERT(!server_interface.violation.load());
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(ServerSynchronizationTest);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -0,0 +1,166 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/tests/timer_wheel.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * Tests expiry of calls in the timer wheel.
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tUnitTestSuite.h"
+#include <thread>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/internal/tCallStorage.h"
+#include "plugins/rpc_ports/internal/tTimerWheel.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+/*! Maximum time any test waits for the wheel */
+const rrlib::time::tDuration cMAX_WAIT = std::chrono::seconds(3);
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+class TimerWheelTest : public rrlib::util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(TimerWheelTest);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestExpiry);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestCompletionBeforeDeadline);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestCascade);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+  /*!
+   * Adds call with specified timeout to timer wheel
+   */
+  internal::tCallStorage::tPointer AddCall(const rrlib::time::tDuration& timeout)
+  {
+    internal::tCallStorage::tPointer call = internal::tCallStorage::GetUnused();
+    call->SetDeadline(internal::tCallStorage::DeadlineFromTimeout(timeout));
+    internal::tTimerWheel::Add(*call);
+    return call;
+  }
+
+  /*!
+   * Waits until the wheel contains the specified number of calls
+   *
+   * \return True if wheel contains the specified number of calls before cMAX_WAIT expires
+   */
+  bool WaitForCallCount(size_t count)
+  {
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + cMAX_WAIT;
+    while (internal::tTimerWheel::GetCallCount() != count)
+    {
+      if (std::chrono::steady_clock::now() > deadline)
+      {
+        return false;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+  }
+
+  void TestExpiry()
+  {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    internal::tCallStorage::tPointer call = AddCall(std::chrono::milliseconds(20));
+    call->WaitForCompletion(cMAX_WAIT);
+    RRLIB_UNIT_TESTS_EQUALITY(call->GetFutureStatus(), tFutureStatus::TIMEOUT);
+    RRLIB_UNIT_TESTS_ASSERT(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(20));
+    RRLIB_UNIT_TESTS_ASSERT(WaitForCallCount(0));
+  }
+
+  void TestCompletionBeforeDeadline()
+  {
+    RRLIB_UNIT_TESTS_ASSERT(WaitForCallCount(0));
+    internal::tCallStorage::tPointer call = AddCall(std::chrono::seconds(10));
+    RRLIB_UNIT_TESTS_ASSERT(WaitForCallCount(1));
+    call->SetException(tFutureStatus::NO_CONNECTION);
+    RRLIB_UNIT_TESTS_ASSERT(WaitForCallCount(0));
+    RRLIB_UNIT_TESTS_EQUALITY(call->GetFutureStatus(), tFutureStatus::NO_CONNECTION);
+  }
+
+  void TestCascade()
+  {
+    // Deadlines beyond the lowest level (64 ticks) are cascaded to lower levels before they expire
+    const int cTIMEOUTS_MS[] = { 300, 100, 200, 150 };
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector<internal::tCallStorage::tPointer> calls;
+    for (int timeout : cTIMEOUTS_MS)
+    {
+      calls.emplace_back(AddCall(std::chrono::milliseconds(timeout)));
+    }
+    RRLIB_UNIT_TESTS_ASSERT(WaitForCallCount(calls.size()));
+    for (size_t i = 0; i < calls.size(); i++)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY(calls[i]->GetFutureStatus(), tFutureStatus::PENDING);
+    }
+
+    for (size_t i = 0; i < calls.size(); i++)
+    {
+      calls[i]->WaitForCompletion(cMAX_WAIT);
+      RRLIB_UNIT_TESTS_EQUALITY(calls[i]->GetFutureStatus(), tFutureStatus::TIMEOUT);
+      RRLIB_UNIT_TESTS_ASSERT(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(cTIMEOUTS_MS[i]));
+    }
+    RRLIB_UNIT_TESTS_ASSERT(WaitForCallCount(0));
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(TimerWheelTest);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
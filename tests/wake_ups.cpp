@@ -0,0 +1,204 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/tests/wake_ups.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * Counts futex wake-ups performed for completing calls.
+ * A thread is only woken up if it actually blocks waiting for a result -
+ * and waiting for a group of futures requires a single wake-up only.
+ * (wake-ups are only counted in debug builds - see FINROC_RPC_PORTS_COUNT_WAKE_UPS)
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tUnitTestSuite.h"
+#include <thread>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/tClientPort.h"
+#include "plugins/rpc_ports/tServerPort.h"
+#include "plugins/rpc_ports/tThreadPoolExecutor.h"
+#include "plugins/rpc_ports/internal/tFutex.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+/*! Number of futures that are waited for in group tests */
+const size_t cGROUP_SIZE = 4;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+#ifdef FINROC_RPC_PORTS_COUNT_WAKE_UPS
+
+class tWakeUpTestInterface : public tRPCInterface
+{
+public:
+  int Function(int value, int delay_ms) const
+  {
+    if (delay_ms)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+    }
+    return value + 1;
+  }
+};
+
+tRPCInterfaceType<tWakeUpTestInterface> cWAKE_UP_TEST_TYPE("Wake-up test interface", &tWakeUpTestInterface::Function);
+
+
+class WakeUpsTest : public rrlib::util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(WakeUpsTest);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestLocalCall);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestNoWaiter);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestUncontendedCall);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestGroup);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+  tWakeUpTestInterface test_interface;
+
+  /*! Calls executed in calling thread complete before anybody waits */
+  void TestLocalCall()
+  {
+    tClientPort<tWakeUpTestInterface> client_port("Client port");
+    tServerPort<tWakeUpTestInterface> server_port(test_interface, "Server port");
+    client_port.ConnectTo(server_port);
+
+    uint64_t wake_count = internal::tFutex::GetWakeCount();
+    for (int i = 0; i < 100; i++)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY(client_port.CallSynchronous(std::chrono::seconds(2), &tWakeUpTestInterface::Function, i, 0), i + 1);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(internal::tFutex::GetWakeCount(), wake_count);
+  }
+
+  /*! Calls that complete in another thread without a thread waiting for them must not wake anybody */
+  void TestNoWaiter()
+  {
+    tThreadPoolExecutor executor(2);
+    tClientPort<tWakeUpTestInterface> client_port("Client port");
+    tServerPort<tWakeUpTestInterface> server_port(test_interface, "Server port", executor);
+    client_port.ConnectTo(server_port);
+
+    uint64_t wake_count = internal::tFutex::GetWakeCount();
+    tFuture<int> future = client_port.FutureCall(&tWakeUpTestInterface::Function, 1, 0);
+    while (!future.Ready())
+    {
+      std::this_thread::yield();
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(future.Get(), 2);
+
+    std::vector<tFuture<int>> futures;
+    for (size_t i = 0; i < cGROUP_SIZE; i++)
+    {
+      futures.emplace_back(client_port.FutureCall(&tWakeUpTestInterface::Function, static_cast<int>(i), 0));
+    }
+    for (auto & f : futures)
+    {
+      while (!f.Ready())
+      {
+        std::this_thread::yield();
+      }
+    }
+    RRLIB_UNIT_TESTS_ASSERT(WhenAll(std::chrono::seconds(2), futures));
+    RRLIB_UNIT_TESTS_EQUALITY(internal::tFutex::GetWakeCount(), wake_count);
+  }
+
+  /*! A thread blocking for the result of a call is woken up exactly once */
+  void TestUncontendedCall()
+  {
+    tThreadPoolExecutor executor(1);
+    tClientPort<tWakeUpTestInterface> client_port("Client port");
+    tServerPort<tWakeUpTestInterface> server_port(test_interface, "Server port", executor);
+    client_port.ConnectTo(server_port);
+
+    for (int i = 0; i < 10; i++)
+    {
+      uint64_t wake_count = internal::tFutex::GetWakeCount();
+      RRLIB_UNIT_TESTS_EQUALITY(client_port.CallSynchronous(std::chrono::seconds(2), tWaitPolicy(tWaitMode::BLOCK), &tWakeUpTestInterface::Function, i, 10), i + 1);
+      RRLIB_UNIT_TESTS_ASSERT(internal::tFutex::GetWakeCount() - wake_count <= 1);
+    }
+  }
+
+  /*! Waiting for a group of futures requires at most one wake-up - regardless of group size */
+  void TestGroup()
+  {
+    tThreadPoolExecutor executor(cGROUP_SIZE);
+    tClientPort<tWakeUpTestInterface> client_port("Client port");
+    tServerPort<tWakeUpTestInterface> server_port(test_interface, "Server port", executor);
+    client_port.ConnectTo(server_port);
+
+    uint64_t wake_count = internal::tFutex::GetWakeCount();
+    std::vector<tFuture<int>> futures;
+    for (size_t i = 0; i < cGROUP_SIZE; i++)
+    {
+      futures.emplace_back(client_port.FutureCall(&tWakeUpTestInterface::Function, static_cast<int>(i), 10));
+    }
+    RRLIB_UNIT_TESTS_ASSERT(WhenAll(std::chrono::seconds(2), futures));
+    RRLIB_UNIT_TESTS_ASSERT(internal::tFutex::GetWakeCount() - wake_count <= 1);
+    for (size_t i = 0; i < cGROUP_SIZE; i++)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY(futures[i].Get(), static_cast<int>(i) + 1);
+    }
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(WakeUpsTest);
+
+#endif
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
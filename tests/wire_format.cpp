@@ -0,0 +1,549 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/rpc_ports/tests/wire_format.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-16
+ *
+ * Tests serializing and deserializing calls with both wire format encodings.
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tUnitTestSuite.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/rpc_ports/tClientPort.h"
+#include "plugins/rpc_ports/tServerPort.h"
+#include "plugins/rpc_ports/internal/tCallIdGenerator.h"
+#include "plugins/rpc_ports/internal/tResponseSender.h"
+#include "plugins/rpc_ports/internal/tRPCInterfaceTypeInfo.h"
+#include "plugins/rpc_ports/internal/tValueBlock.h"
+#include "plugins/rpc_ports/internal/tWireFormat.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace rpc_ports
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+class tWireFormatTestInterface : public tRPCInterface
+{
+public:
+  tWireFormatTestInterface() : stored_value(0) {}
+
+  int Multiply(int a, int b)
+  {
+    return a * b;
+  }
+
+  void Store(int value)
+  {
+    stored_value = value;
+  }
+
+  int stored_value;
+};
+
+tRPCInterfaceType<tWireFormatTestInterface> cWIRE_FORMAT_TEST_TYPE("Wire format test interface", &tWireFormatTestInterface::Multiply, &tWireFormatTestInterface::Store);
+
+/*! Plain data type that opts in to raw block serialization */
+struct tWireFormatTestPose
+{
+  double x, y, yaw;
+};
+
+static_assert(sizeof(tWireFormatTestPose) == 3 * sizeof(double), "Types transferred as raw blocks must not contain padding");
+
+rrlib::serialization::tOutputStream& operator<<(rrlib::serialization::tOutputStream& stream, const tWireFormatTestPose& pose)
+{
+  stream << pose.x << pose.y << pose.yaw;
+  return stream;
+}
+
+rrlib::serialization::tInputStream& operator>>(rrlib::serialization::tInputStream& stream, tWireFormatTestPose& pose)
+{
+  stream >> pose.x >> pose.y >> pose.yaw;
+  return stream;
+}
+
+template <>
+struct tRawBlockSerializable<tWireFormatTestPose>
+{
+  enum { value = 1 };
+};
+
+/*! Plain data type that does not opt in to raw block serialization */
+struct tWireFormatTestPoint
+{
+  double x, y;
+};
+
+static_assert(internal::tValueBlock<std::tuple<tWireFormatTestPose, int>>::cTAGGED, "Opted-in type must be transferred as raw block");
+static_assert(!internal::tValueBlock<std::tuple<tWireFormatTestPoint, int>>::cTAGGED, "Classes must opt in to raw block serialization");
+static_assert(!internal::tValueBlock<std::tuple<int, double>>::cTAGGED, "Numbers are not tagged");
+
+/*! Network port that keeps the calls sent to it */
+class tWireFormatTestNetworkPort : public internal::tRPCPort
+{
+public:
+  /*!
+   * \param connection_wire_format Wire format of simulated connection (NULL if calls are not forwarded to this port)
+   */
+  tWireFormatTestNetworkPort(core::tAbstractPortCreationInfo creation_info, const internal::tWireFormat* connection_wire_format = NULL) :
+    internal::tRPCPort(creation_info, NULL),
+    connection_wire_format(connection_wire_format)
+  {}
+
+  virtual bool AcceptsForwardedParameters(const internal::tWireFormat& source_wire_format) const override
+  {
+    return connection_wire_format && connection_wire_format->HasCompatibleParameterEncoding(source_wire_format);
+  }
+
+  std::vector<tCallPointer> sent_calls;
+
+private:
+
+  const internal::tWireFormat* connection_wire_format;
+
+  virtual void SendCall(tCallPointer && call_to_send) override
+  {
+    sent_calls.push_back(std::move(call_to_send));
+  }
+};
+
+/*! Response sender that keeps the responses sent to it */
+class tWireFormatTestResponseSender : public internal::tResponseSender
+{
+public:
+  std::vector<tCallPointer> responses;
+
+private:
+  virtual void SendResponse(tCallPointer && response_to_send) override
+  {
+    responses.push_back(std::move(response_to_send));
+  }
+};
+
+class WireFormatTest : public rrlib::util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(WireFormatTest);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestCompactRoundTrip);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestLegacyRoundTrip);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestForwarding);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestInvalidBufferSize);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestRawBlocks);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestVarints);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+  void TestCompactRoundTrip()
+  {
+    TestRoundTrip(internal::tWireFormat::tEncoding::COMPACT);
+  }
+
+  void TestLegacyRoundTrip()
+  {
+    TestRoundTrip(internal::tWireFormat::tEncoding::LEGACY);
+  }
+
+  /*!
+   * Sends requests and messages from client to server over a simulated connection (memory streams) - and responses back.
+   * Checks that interface types are registered with the first call only - and again after both sides are reset.
+   */
+  void TestRoundTrip(internal::tWireFormat::tEncoding encoding)
+  {
+    bool compact = encoding == internal::tWireFormat::tEncoding::COMPACT;
+    internal::tWireFormat client_side(encoding), server_side(encoding);
+    tClientPort<tWireFormatTestInterface> client_port("Client");
+    core::tAbstractPortCreationInfo creation_info;
+    creation_info.name = "Network port";
+    creation_info.data_type = cWIRE_FORMAT_TEST_TYPE;
+    creation_info.flags |= core::tFrameworkElement::tFlag::NETWORK_ELEMENT | core::tFrameworkElement::tFlag::ACCEPTS_DATA | core::tFrameworkElement::tFlag::EMITS_DATA;
+    tWireFormatTestNetworkPort* network_port = new tWireFormatTestNetworkPort(creation_info);
+    client_port.GetWrapped()->ConnectTo(*network_port);
+
+    tWireFormatTestInterface server_object;
+    tClientPort<tWireFormatTestInterface> remote_client_port("Remote client");
+    tServerPort<tWireFormatTestInterface> server_port(server_object, "Server");
+    remote_client_port.ConnectTo(server_port);
+
+    size_t request_sizes[3];
+    for (size_t round = 0; round < 3; round++)
+    {
+      if (round == 2)
+      {
+        // e.g. connection is re-established
+        client_side.Reset();
+        server_side.Reset();
+      }
+
+      // Request
+      int factor = static_cast<int>(round) + 2;
+      auto future = client_port.FutureCall(std::chrono::seconds(2), &tWireFormatTestInterface::Multiply, factor, 7);
+      RRLIB_UNIT_TESTS_EQUALITY(network_port->sent_calls.size(), 1u);
+      internal::tRPCPort::tCallPointer request = std::move(network_port->sent_calls[0]);
+      network_port->sent_calls.clear();
+      rrlib::serialization::tMemoryBuffer request_buffer;
+      {
+        rrlib::serialization::tOutputStream stream(request_buffer);
+        request->GetCall()->Serialize(stream, client_side);
+        stream.Close();
+      }
+      request_sizes[round] = request_buffer.GetSize();
+
+      tWireFormatTestResponseSender response_sender;
+      {
+        rrlib::serialization::tInputStream stream(request_buffer);
+        rrlib::rtti::tType type = server_side.ReadInterfaceType(stream);
+        RRLIB_UNIT_TESTS_ASSERT(type == rrlib::rtti::tType(cWIRE_FORMAT_TEST_TYPE));
+        uint8_t function_index;
+        stream >> function_index;
+        type.GetAnnotation<internal::tRPCInterfaceTypeInfo>()->DeserializeRequest(stream, *remote_client_port.GetWrapped(), function_index, response_sender, server_side);
+      }
+      RRLIB_UNIT_TESTS_EQUALITY(response_sender.responses.size(), 1u);
+
+      // Response
+      rrlib::serialization::tMemoryBuffer response_buffer;
+      {
+        rrlib::serialization::tOutputStream stream(response_buffer);
+        response_sender.responses[0]->GetCall()->Serialize(stream, server_side);
+        stream.Close();
+      }
+      {
+        rrlib::serialization::tInputStream stream(response_buffer);
+        rrlib::rtti::tType type = client_side.ReadInterfaceType(stream);
+        RRLIB_UNIT_TESTS_ASSERT(type == rrlib::rtti::tType(cWIRE_FORMAT_TEST_TYPE));
+        uint8_t function_index;
+        stream >> function_index;
+        RRLIB_UNIT_TESTS_EQUALITY(client_side.ReadCallId(stream), request->GetCallId());
+        type.GetAnnotation<internal::tRPCInterfaceTypeInfo>()->DeserializeResponse(stream, function_index, response_sender, request.get(), client_side);
+      }
+      RRLIB_UNIT_TESTS_EQUALITY(future.Get(), factor * 7);
+
+      // Message
+      client_port.Call(&tWireFormatTestInterface::Store, factor);
+      RRLIB_UNIT_TESTS_EQUALITY(network_port->sent_calls.size(), 1u);
+      rrlib::serialization::tMemoryBuffer message_buffer;
+      {
+        rrlib::serialization::tOutputStream stream(message_buffer);
+        network_port->sent_calls[0]->GetCall()->Serialize(stream, client_side);
+        stream.Close();
+      }
+      network_port->sent_calls.clear();
+      {
+        rrlib::serialization::tInputStream stream(message_buffer);
+        rrlib::rtti::tType type = server_side.ReadInterfaceType(stream);
+        uint8_t function_index;
+        stream >> function_index;
+        type.GetAnnotation<internal::tRPCInterfaceTypeInfo>()->DeserializeMessage(stream, *remote_client_port.GetWrapped(), function_index, server_side);
+      }
+      RRLIB_UNIT_TESTS_EQUALITY(server_object.stored_value, factor);
+    }
+
+    if (compact)
+    {
+      // Interface type is only transferred with first call - handle is reused afterwards
+      RRLIB_UNIT_TESTS_ASSERT(request_sizes[1] < request_sizes[0]);
+    }
+    else
+    {
+      RRLIB_UNIT_TESTS_EQUALITY(request_sizes[1], request_sizes[0]);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(request_sizes[2], request_sizes[0]);
+  }
+
+  /*!
+   * Sends request from client over a routing runtime environment to server (compact encoding on both connections) - and the response back.
+   * The router forwards the serialized parameters without deserializing them.
+   */
+  void TestForwarding()
+  {
+    internal::tWireFormat client_side(internal::tWireFormat::tEncoding::COMPACT), router_from_client(internal::tWireFormat::tEncoding::COMPACT),
+             router_to_server(internal::tWireFormat::tEncoding::COMPACT), router_to_legacy_server(internal::tWireFormat::tEncoding::LEGACY),
+             server_side(internal::tWireFormat::tEncoding::COMPACT);
+    core::tAbstractPortCreationInfo creation_info;
+    creation_info.data_type = cWIRE_FORMAT_TEST_TYPE;
+    creation_info.flags |= core::tFrameworkElement::tFlag::NETWORK_ELEMENT | core::tFrameworkElement::tFlag::ACCEPTS_DATA | core::tFrameworkElement::tFlag::EMITS_DATA;
+
+    tClientPort<tWireFormatTestInterface> client_port("Client");
+    creation_info.name = "Client network port";
+    tWireFormatTestNetworkPort* client_network_port = new tWireFormatTestNetworkPort(creation_info);
+    client_port.GetWrapped()->ConnectTo(*client_network_port);
+
+    tClientPort<tWireFormatTestInterface> router_port("Router");
+    creation_info.name = "Router network port";
+    tWireFormatTestNetworkPort* router_network_port = new tWireFormatTestNetworkPort(creation_info, &router_to_server);
+    router_port.GetWrapped()->ConnectTo(*router_network_port);
+    tClientPort<tWireFormatTestInterface> legacy_router_port("Legacy router");
+    creation_info.name = "Legacy router network port";
+    tWireFormatTestNetworkPort* legacy_router_network_port = new tWireFormatTestNetworkPort(creation_info, &router_to_legacy_server);
+    legacy_router_port.GetWrapped()->ConnectTo(*legacy_router_network_port);
+
+    tWireFormatTestInterface server_object;
+    tClientPort<tWireFormatTestInterface> remote_client_port("Remote client");
+    tServerPort<tWireFormatTestInterface> server_port(server_object, "Server");
+    remote_client_port.ConnectTo(server_port);
+
+    // Client sends request
+    auto future = client_port.FutureCall(std::chrono::seconds(2), &tWireFormatTestInterface::Multiply, 6, 7);
+    RRLIB_UNIT_TESTS_EQUALITY(client_network_port->sent_calls.size(), 1u);
+    internal::tRPCPort::tCallPointer request = std::move(client_network_port->sent_calls[0]);
+    client_network_port->sent_calls.clear();
+    request->SetCallId(internal::tCallIdGenerator::Next());
+    rrlib::serialization::tMemoryBuffer request_buffer;
+    {
+      rrlib::serialization::tOutputStream stream(request_buffer);
+      request->GetCall()->Serialize(stream, client_side);
+      stream.Close();
+    }
+
+    // Router forwards request
+    tWireFormatTestResponseSender router_response_sender;
+    std::vector<uint8_t> parameters;
+    {
+      rrlib::serialization::tInputStream stream(request_buffer);
+      rrlib::rtti::tType type = router_from_client.ReadInterfaceType(stream);
+      uint8_t function_index;
+      stream >> function_index;
+      internal::tCallId call_id = router_from_client.ReadCallId(stream);
+      RRLIB_UNIT_TESTS_EQUALITY(call_id, request->GetCallId());
+      router_from_client.ReadTimeout(stream);
+      parameters.resize(stream.Remaining());
+      stream.ReadFully(parameters.data(), parameters.size());
+      internal::tRPCInterfaceTypeInfo* type_info = type.GetAnnotation<internal::tRPCInterfaceTypeInfo>();
+
+      // Parameters of compact connections cannot be written unchanged to legacy connections
+      tRPCBuffer parameter_buffer((std::vector<uint8_t>(parameters)));
+      RRLIB_UNIT_TESTS_ASSERT(!type_info->ForwardRequest(*legacy_router_port.GetWrapped(), function_index, call_id, std::chrono::seconds(1), std::move(parameter_buffer),
+                              router_response_sender, router_from_client));
+      RRLIB_UNIT_TESTS_EQUALITY(parameter_buffer.Size(), parameters.size());
+      RRLIB_UNIT_TESTS_ASSERT(legacy_router_network_port->sent_calls.empty());
+      RRLIB_UNIT_TESTS_ASSERT(router_response_sender.responses.empty());
+
+      RRLIB_UNIT_TESTS_ASSERT(type_info->ForwardRequest(*router_port.GetWrapped(), function_index, call_id, std::chrono::seconds(1), std::move(parameter_buffer),
+                              router_response_sender, router_from_client));
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(router_network_port->sent_calls.size(), 1u);
+    RRLIB_UNIT_TESTS_EQUALITY(router_response_sender.responses.size(), 1u);
+    internal::tRPCPort::tCallPointer forwarded_request = std::move(router_network_port->sent_calls[0]);
+    router_network_port->sent_calls.clear();
+    forwarded_request->SetCallId(internal::tCallIdGenerator::Next());
+    rrlib::serialization::tMemoryBuffer forwarded_request_buffer;
+    {
+      rrlib::serialization::tOutputStream stream(forwarded_request_buffer);
+      forwarded_request->GetCall()->Serialize(stream, router_to_server);
+      stream.Close();
+    }
+
+    // Server receives request with rewritten header and unchanged parameters
+    tWireFormatTestResponseSender server_response_sender;
+    {
+      // Inspect header with separate wire format - as interface type handle registration is read again below
+      internal::tWireFormat inspection_side(internal::tWireFormat::tEncoding::COMPACT);
+      rrlib::serialization::tInputStream stream(forwarded_request_buffer);
+      rrlib::rtti::tType type = inspection_side.ReadInterfaceType(stream);
+      RRLIB_UNIT_TESTS_ASSERT(type == rrlib::rtti::tType(cWIRE_FORMAT_TEST_TYPE));
+      uint8_t function_index;
+      stream >> function_index;
+      internal::tCallId call_id = inspection_side.ReadCallId(stream);
+      RRLIB_UNIT_TESTS_EQUALITY(call_id, forwarded_request->GetCallId());
+      RRLIB_UNIT_TESTS_ASSERT(call_id != request->GetCallId());
+      rrlib::time::tDuration timeout = inspection_side.ReadTimeout(stream);
+      RRLIB_UNIT_TESTS_ASSERT(timeout > rrlib::time::tDuration::zero() && timeout <= std::chrono::seconds(1));
+      std::vector<uint8_t> forwarded_parameters(stream.Remaining());
+      stream.ReadFully(forwarded_parameters.data(), forwarded_parameters.size());
+      RRLIB_UNIT_TESTS_ASSERT(forwarded_parameters == parameters);
+    }
+    {
+      rrlib::serialization::tInputStream stream(forwarded_request_buffer);
+      rrlib::rtti::tType type = server_side.ReadInterfaceType(stream);
+      uint8_t function_index;
+      stream >> function_index;
+      type.GetAnnotation<internal::tRPCInterfaceTypeInfo>()->DeserializeRequest(stream, *remote_client_port.GetWrapped(), function_index, server_response_sender, server_side);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(server_response_sender.responses.size(), 1u);
+
+    // Response is returned via router to client
+    rrlib::serialization::tMemoryBuffer response_buffer;
+    {
+      rrlib::serialization::tOutputStream stream(response_buffer);
+      server_response_sender.responses[0]->GetCall()->Serialize(stream, server_side);
+      stream.Close();
+    }
+    {
+      rrlib::serialization::tInputStream stream(response_buffer);
+      rrlib::rtti::tType type = router_to_server.ReadInterfaceType(stream);
+      uint8_t function_index;
+      stream >> function_index;
+      RRLIB_UNIT_TESTS_EQUALITY(router_to_server.ReadCallId(stream), forwarded_request->GetCallId());
+      type.GetAnnotation<internal::tRPCInterfaceTypeInfo>()->DeserializeResponse(stream, function_index, router_response_sender, forwarded_request.get(), router_to_server);
+    }
+    rrlib::serialization::tMemoryBuffer forwarded_response_buffer;
+    {
+      rrlib::serialization::tOutputStream stream(forwarded_response_buffer);
+      router_response_sender.responses[0]->GetCall()->Serialize(stream, router_from_client);
+      stream.Close();
+    }
+    {
+      rrlib::serialization::tInputStream stream(forwarded_response_buffer);
+      rrlib::rtti::tType type = client_side.ReadInterfaceType(stream);
+      uint8_t function_index;
+      stream >> function_index;
+      RRLIB_UNIT_TESTS_EQUALITY(client_side.ReadCallId(stream), request->GetCallId());
+      tWireFormatTestResponseSender response_sender;
+      type.GetAnnotation<internal::tRPCInterfaceTypeInfo>()->DeserializeResponse(stream, function_index, response_sender, request.get(), client_side);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(future.Get(), 42);
+  }
+
+  void TestInvalidBufferSize()
+  {
+    const uint64_t cSIZES[] = { 5, 1ull << 32, ~0ull };
+    for (uint64_t size : cSIZES)
+    {
+      rrlib::serialization::tMemoryBuffer buffer;
+      {
+        rrlib::serialization::tOutputStream stream(buffer);
+        stream << size;
+        stream.WriteByte(1);
+        stream.Close();
+      }
+      bool thrown = false;
+      try
+      {
+        rrlib::serialization::tInputStream stream(buffer);
+        internal::tWireFormat::Legacy().ReadBuffer(stream);
+      }
+      catch (const std::runtime_error&)
+      {
+        thrown = true;
+      }
+      RRLIB_UNIT_TESTS_ASSERT(thrown);
+    }
+  }
+
+  void TestRawBlocks()
+  {
+    typedef std::tuple<tWireFormatTestPose, int> tValues;
+    typedef internal::tValueBlock<tValues> tBlock;
+    tValues values(tWireFormatTestPose { 1.5, -2.0, 0.25 }, 7);
+    internal::tWireFormat wire_format(internal::tWireFormat::tEncoding::COMPACT);
+    size_t sizes[2];
+    for (int raw = 0; raw < 2; raw++)
+    {
+      wire_format.SetRawBlocksEnabled(raw);
+      rrlib::serialization::tMemoryBuffer buffer;
+      {
+        rrlib::serialization::tOutputStream stream(buffer);
+        tBlock::Serialize(stream, values, wire_format);
+        stream.Close();
+      }
+      sizes[raw] = buffer.GetSize();
+
+      // Both variants can be read - independent of the receiver's raw block setting
+      tValues deserialized;
+      rrlib::serialization::tInputStream stream(buffer);
+      tBlock::Deserialize(stream, deserialized, internal::tWireFormat(internal::tWireFormat::tEncoding::COMPACT));
+      RRLIB_UNIT_TESTS_ASSERT(std::get<0>(deserialized).x == 1.5 && std::get<0>(deserialized).y == -2.0 && std::get<0>(deserialized).yaw == 0.25);
+      RRLIB_UNIT_TESTS_EQUALITY(std::get<1>(deserialized), 7);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(sizes[0], 1 + 3 * sizeof(double) + sizeof(int));
+    RRLIB_UNIT_TESTS_EQUALITY(sizes[1], 2 + sizeof(tWireFormatTestPose) + sizeof(int));
+  }
+
+  void TestVarints()
+  {
+    const uint64_t cVALUES[] = { 0, 1, 127, 128, 300, 1ull << 40, ~0ull };
+    const size_t cSIZES[] = { 1, 1, 1, 2, 2, 6, 10 };
+    for (size_t i = 0; i < sizeof(cVALUES) / sizeof(cVALUES[0]); i++)
+    {
+      rrlib::serialization::tMemoryBuffer buffer;
+      {
+        rrlib::serialization::tOutputStream stream(buffer);
+        internal::tWireFormat::WriteVarint(stream, cVALUES[i]);
+        stream.Close();
+      }
+      RRLIB_UNIT_TESTS_EQUALITY(buffer.GetSize(), cSIZES[i]);
+      rrlib::serialization::tInputStream stream(buffer);
+      RRLIB_UNIT_TESTS_EQUALITY(internal::tWireFormat::ReadVarint(stream), cVALUES[i]);
+    }
+
+    // 10th byte may only contain the most significant bit
+    rrlib::serialization::tMemoryBuffer buffer;
+    {
+      rrlib::serialization::tOutputStream stream(buffer);
+      for (size_t i = 0; i < 9; i++)
+      {
+        stream.WriteByte(static_cast<int8_t>(0xFF));
+      }
+      stream.WriteByte(2);
+      stream.Close();
+    }
+    bool thrown = false;
+    try
+    {
+      rrlib::serialization::tInputStream stream(buffer);
+      internal::tWireFormat::ReadVarint(stream);
+    }
+    catch (const std::runtime_error&)
+    {
+      thrown = true;
+    }
+    RRLIB_UNIT_TESTS_ASSERT(thrown);
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(WireFormatTest);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}